@@ -6,15 +6,19 @@
 #include "Geometry.hpp"
 #include "Widget.hpp"
 #include "NanoVG.hpp"
+#include "AnimationEngine.hpp"
 
-#include <chrono>
-#include <functional>
 #include <memory>
 
 START_NAMESPACE_DISTRHO
 
 using DGL_NAMESPACE::Color;
 
+/**
+ * A handle on a track of an AnimationEngine, which advances all the animations of a window once per frame.
+ * Transitions add their tweens to the track when they are built; an animation holds no value itself.
+ * A widget gets the engine of its window from its FrameScheduler.
+ */
 class Animation
 {
 public:
@@ -36,46 +40,49 @@ public:
     easeOutPower2,
     easeOutPower4,
     easeInPower2,
-    easeInPower4
+    easeInPower4,
+    easeInOutPower3,
+    easeOutSpring,
+
+    easingFunctionCount
   };
 
-  Animation(float duration, EasingFunction easingFunction = noEasing);
+  Animation(AnimationEngine &engine, float duration, EasingFunction easingFunction = noEasing);
+  Animation(const Animation &other);
+  Animation(Animation &&other);
   ~Animation();
 
+  Animation &operator=(const Animation &other);
+  Animation &operator=(Animation &&other);
+
   void play(PlaybackDirection playbackDirection = Forward, RepeatMode repeatMode = NoRepeat);
   void pause();
   void seek(float time);
   void rewind();
 
-  virtual void run() = 0;
-
   bool isPlaying();
 
   void setDuration(float duration);
   void setSpeed(float speed);
 
+  /**
+   * Use an EasingFunction, or a curve registered with AnimationEngine::addCubicBezierEasing() and addSpringEasing().
+   */
+  void setEasing(int easing);
+
   float getCurrentTime();
   float getDuration();
 
 protected:
-  void synchronize();
-  void pauseIfDone();
-
-  virtual void onPlay();
-  virtual void onSeek();
-  virtual void onDurationChange();
-  virtual void onSpeedChange();
+  /**
+   * An animation without a track, to be assigned a real one later.
+   */
+  Animation();
 
-  virtual void applyEasing();
+  void addTween(float *value, float targetValue);
 
-  float fDuration;
-  float fCurrentTime;
-  float fSpeed;
-  std::chrono::steady_clock::time_point fTimeLastRun;
-  PlaybackDirection fPlaybackDirection;
-  RepeatMode fRepeatMode;
-  EasingFunction fEasingFunction;
-  bool fIsPlaying;
+  std::shared_ptr<AnimationEngine> fEngine;
+  int fTrack;
 
 private:
   DISTRHO_LEAK_DETECTOR(Animation)
@@ -85,61 +92,26 @@ class FloatTransition : public Animation
 {
 public:
   FloatTransition();
-
-  FloatTransition(float duration, float *initialValue, float targetValue, EasingFunction easingFunction = noEasing);
-  virtual ~FloatTransition();
-
-  void run() override;
-
-protected:
-  void applyEasing() override;
-
-  float fInitialValue;
-  float *fCurrentValue;
-  float fTargetValue;
+  FloatTransition(AnimationEngine &engine, float duration, float *initialValue, float targetValue, EasingFunction easingFunction = noEasing);
 
 private:
   DISTRHO_LEAK_DETECTOR(FloatTransition)
 };
 
-class AnimationContainer : public Animation
-{
-public:
-  AnimationContainer(float duration, EasingFunction easingFunction = noEasing);
-  virtual ~AnimationContainer();
-
-  void run() override;
-
-  void onPlay() override;
-  void onSeek() override;
-  void onDurationChange() override;
-  void onSpeedChange() override;
-
-protected:
-  void applyEasing() override;
-
-  std::vector<std::shared_ptr<Animation>> fAnimations;
-
-private:
-  DISTRHO_LEAK_DETECTOR(AnimationContainer)
-};
-
-class ColorTransition : public AnimationContainer
+class ColorTransition : public Animation
 {
 public:
-  ColorTransition(float duration, Color *initialColor, Color targetColor, EasingFunction easingFunction = noEasing);
-  virtual ~ColorTransition();
+  ColorTransition(AnimationEngine &engine, float duration, Color *initialColor, Color targetColor, EasingFunction easingFunction = noEasing);
 
 private:
   DISTRHO_LEAK_DETECTOR(ColorTransition)
 };
 
-class GradientTransition : public AnimationContainer
+class GradientTransition : public Animation
 {
 public:
   GradientTransition();
-  GradientTransition(float duration, NanoVG::Paint *initialGradient, NanoVG::Paint targetGradient, EasingFunction easingFunction = noEasing);
-  virtual ~GradientTransition();
+  GradientTransition(AnimationEngine &engine, float duration, NanoVG::Paint *initialGradient, NanoVG::Paint targetGradient, EasingFunction easingFunction = noEasing);
 
 private:
   DISTRHO_LEAK_DETECTOR(GradientTransition)
@@ -0,0 +1,102 @@
+#ifndef WOLF_ANIMATION_ENGINE_DEFINED_H
+#define WOLF_ANIMATION_ENGINE_DEFINED_H
+
+#include "src/DistrhoDefines.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+START_NAMESPACE_DISTRHO
+
+/**
+ * Advances the animations of one window at once.
+ * An animation is a track (its time, duration, speed and direction) driving one or more tweens,
+ * each of them interpolating a float between two values. Tracks and tweens are stored as arrays of their fields,
+ * so a frame is one clock sample and two passes over contiguous memory.
+ * An engine isn't synchronized: it belongs to the thread of its window, which owns it through its FrameScheduler.
+ * Animations share that ownership, since a widget detaches from its scheduler before its animations are destroyed.
+ */
+class AnimationEngine : public std::enable_shared_from_this<AnimationEngine>
+{
+public:
+  AnimationEngine();
+
+  int createTrack(float duration, int easing);
+  int cloneTrack(int track);
+  void destroyTrack(int track);
+
+  /**
+   * Start moving @a track forward if @a direction is positive, backward otherwise.
+   */
+  void play(int track, int direction, std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+  void pause(int track);
+  void seek(int track, float time, std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+  bool isPlaying(int track) const;
+  float getTime(int track) const;
+  float getDuration(int track) const;
+
+  void setDuration(int track, float duration);
+  void setSpeed(int track, float speed);
+
+  /**
+   * Make @a track drive the float at @a target, from its current value to @a to.
+   */
+  void addTween(int track, float *target, float to);
+
+  void setEasing(int track, int easing);
+
+  /**
+   * Register an easing curve, returning its id for setEasing().
+   * The curve is sampled once into a table, so its shape costs nothing per frame.
+   * A cubic bezier goes from (0, 0) to (1, 1) through the given control points, like the CSS timing function.
+   * A spring overshoots and oscillates around its target, @a damping setting how fast it settles.
+   */
+  int addCubicBezierEasing(float x1, float y1, float x2, float y2);
+  int addSpringEasing(float damping, float oscillations);
+
+  /**
+   * Step all the playing tracks to @a now and write the values of their tweens.
+   */
+  void advance(std::chrono::steady_clock::time_point now);
+
+private:
+  enum TrackFlags
+  {
+    InUse = 1,
+    Playing = 2,
+    Stepped = 4
+  };
+
+  static const int easingResolution = 64;
+
+  int addEasingTable(float (*curve)(float t, const float *params), const float *params);
+  bool isTrack(int track) const;
+
+  //tracks, indexed by the id held by their Animation
+  std::vector<float> fTime;
+  std::vector<float> fDuration;
+  std::vector<float> fSpeed;
+  std::vector<float> fProgress;
+  std::vector<std::chrono::steady_clock::time_point> fLastStep;
+  std::vector<signed char> fDirection;
+  std::vector<int> fEasing;
+  std::vector<unsigned char> fFlags;
+  std::vector<int> fFreeTracks;
+
+  //tweens, in no particular order
+  std::vector<float *> fTargets;
+  std::vector<float> fFrom;
+  std::vector<float> fTo;
+  std::vector<int> fTweenTracks;
+
+  //easing curves, easingResolution + 1 samples each
+  std::vector<float> fEasingTables;
+
+  DISTRHO_DECLARE_NON_COPYABLE(AnimationEngine)
+};
+
+END_NAMESPACE_DISTRHO
+
+#endif
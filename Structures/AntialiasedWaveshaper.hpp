@@ -0,0 +1,51 @@
+#ifndef WOLF_ANTIALIASED_WAVESHAPER_INCLUDED
+#define WOLF_ANTIALIASED_WAVESHAPER_INCLUDED
+
+#include "src/DistrhoDefines.h"
+#include "extra/LeakDetector.hpp"
+#include "Graph.hpp"
+
+START_NAMESPACE_DISTRHO
+
+namespace wolf
+{
+/**
+ * Shapes a signal with a graph using first-order antiderivative anti-aliasing (ADAA).
+ * Each output sample is the average of the graph between the current and the previous input,
+ * computed from the antiderivative of the graph. This removes most of the aliasing of the naive shaping,
+ * so a low oversampling ratio gives the quality of a much higher one. The signal gets delayed by half a sample.
+ * Use one instance per channel.
+ */
+class AntialiasedWaveshaper
+{
+public:
+  /**
+   * The graph must outlive the waveshaper.
+   */
+  AntialiasedWaveshaper(GraphBase &graph);
+
+  /**
+   * Forget the previous input, like at the start of the playback.
+   */
+  void reset();
+
+  /**
+   * Shape a sample. The input is clamped to [-1, 1].
+   */
+  float process(float input);
+
+private:
+  GraphBase &fGraph;
+
+  double fPreviousInput;
+  double fPreviousAntiderivative;
+  unsigned int fGraphRevision;
+
+  DISTRHO_LEAK_DETECTOR(AntialiasedWaveshaper)
+};
+
+} // namespace wolf
+
+END_NAMESPACE_DISTRHO
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef WOLF_ARENA_H_INCLUDED
+#define WOLF_ARENA_H_INCLUDED
+
+#include "src/DistrhoDefines.h"
+#include "extra/LeakDetector.hpp"
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+START_NAMESPACE_DISTRHO
+
+namespace wolf
+{
+/**
+ * A fixed-capacity bump allocator.
+ * All the memory is allocated up front, and is handed out in order until the arena is reset.
+ * Individual allocations are never freed.
+ */
+class Arena
+{
+public:
+  explicit Arena(const size_t capacity);
+  ~Arena();
+
+  /**
+   * Return a pointer to @a size bytes of uninitialized memory, or nullptr if the arena is full.
+   */
+  void *allocate(const size_t size, const size_t alignment = alignof(std::max_align_t));
+
+  /**
+   * Return uninitialized storage for @a count objects of type T, or nullptr if the arena is full.
+   */
+  template <class T>
+  T *allocateArray(const int count);
+
+  /**
+   * Forget about all the allocations made so far. Nothing is destructed.
+   */
+  void reset();
+
+  size_t getCapacity() const;
+  size_t getUsed() const;
+
+private:
+  unsigned char *fMemory;
+  const size_t fCapacity;
+  size_t fUsed;
+
+  DISTRHO_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Arena)
+};
+
+/**
+ * Hands out blocks of a fixed size, carved from an arena when created.
+ * Unlike the arena, blocks can be freed one by one, and are reused by the next allocations.
+ * Neither allocating nor freeing touches the system allocator, so both are safe on the audio thread.
+ */
+class SlabAllocator
+{
+public:
+  SlabAllocator(Arena &arena, const size_t blockSize, const int blockCount, const size_t alignment = alignof(std::max_align_t));
+
+  /**
+   * Return a block of uninitialized memory, or nullptr if all the blocks are in use.
+   */
+  void *allocate();
+  void deallocate(void *block);
+
+  /**
+   * Construct a T in a block, or return nullptr if all the blocks are in use.
+   * T must fit in a block, and not need a stricter alignment than the slab's.
+   */
+  template <class T, typename... Args>
+  T *create(Args &&... args);
+
+  template <class T>
+  void destroy(T *object);
+
+  int getBlockCount() const;
+  int getFreeCount() const;
+
+private:
+  unsigned char *fMemory;
+  size_t fBlockSize;
+  const size_t fAlignment;
+  int fBlockCount;
+
+  //each free block holds a pointer to the next one
+  void *fFreeList;
+  int fFreeCount;
+
+  DISTRHO_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SlabAllocator)
+};
+
+template <class T>
+T *Arena::allocateArray(const int count)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(count >= 0, nullptr);
+
+    return static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+}
+
+template <class T, typename... Args>
+T *SlabAllocator::create(Args &&... args)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(sizeof(T) <= fBlockSize, nullptr);
+    DISTRHO_SAFE_ASSERT_RETURN(alignof(T) <= fAlignment, nullptr);
+
+    void *block = allocate();
+
+    if (block == nullptr)
+        return nullptr;
+
+    return new (block) T(std::forward<Args>(args)...);
+}
+
+template <class T>
+void SlabAllocator::destroy(T *object)
+{
+    if (object == nullptr)
+        return;
+
+    object->~T();
+
+    deallocate(object);
+}
+
+} // namespace wolf
+
+END_NAMESPACE_DISTRHO
+
+#endif
@@ -2,6 +2,10 @@
 
 #include <stdexcept>
 #include <cassert>
+#include <new>
+
+#include "Arena.hpp"
+#include "StaticArray.hpp"
 
 START_NAMESPACE_DISTRHO
 
@@ -13,14 +17,32 @@ class Array
 {
   public:
     explicit Array(const int size);
+
+    /**
+     * Take the storage of the array from @a arena, instead of the heap.
+     */
+    Array(Arena &arena, const int size);
     ~Array();
 
-    void add(const T item);
+    void add(const T &item);
+    void add(T &&item);
+
+    /**
+     * Add @a count items copied from @a items, or none if they don't fit.
+     */
+    bool addRange(const T *items, const int count);
 
     T get(const int index);
     T getLast();
 
     void remove(const int index);
+    void removeRange(const int index, const int count);
+
+    /**
+     * Remove the item at @a index by moving the last one in its place. Constant time, but doesn't keep the order.
+     */
+    void swapRemove(const int index);
+
     void removeFirstMatchingValue(T value);
     void clear();
 
@@ -32,33 +54,89 @@ class Array
     int fCount;
     T *fItems;
     const int fCapacity;
+    const bool fOwnsItems;
 };
 
 template <class T>
 Array<T>::Array(const int capacity) : fCount(0),
                                       fItems(new T[capacity]),
-                                      fCapacity(capacity)
+                                      fCapacity(capacity),
+                                      fOwnsItems(true)
+{
+}
+
+template <class T>
+Array<T>::Array(Arena &arena, const int capacity) : fCount(0),
+                                                    fItems(arena.allocateArray<T>(capacity)),
+                                                    fCapacity(fItems != nullptr ? capacity : 0),
+                                                    fOwnsItems(false)
 {
+    DISTRHO_SAFE_ASSERT(fItems != nullptr);
+
+    for (int i = 0; i < fCapacity; ++i)
+    {
+        new (&fItems[i]) T();
+    }
 }
 
 template <class T>
 Array<T>::~Array()
 {
-    delete[] fItems;
+    if (fOwnsItems)
+    {
+        delete[] fItems;
+        return;
+    }
+
+    //the arena owns the memory, but not the objects in it
+    for (int i = 0; i < fCapacity; ++i)
+    {
+        fItems[i].~T();
+    }
 }
 
 template <class T>
-void Array<T>::add(const T value)
+void Array<T>::add(const T &value)
 {
-    DISTRHO_SAFE_ASSERT(!full());
+    DISTRHO_SAFE_ASSERT_RETURN(!full(), );
 
     fItems[fCount++] = value;
 }
 
+template <class T>
+void Array<T>::add(T &&value)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(!full(), );
+
+    fItems[fCount++] = std::move(value);
+}
+
+template <class T>
+bool Array<T>::addRange(const T *items, const int count)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(count >= 0 && fCount + count <= fCapacity, false);
+
+    if (std::is_trivially_copyable<T>::value)
+    {
+        std::memcpy(static_cast<void *>(&fItems[fCount]), static_cast<const void *>(items), sizeof(T) * count);
+    }
+    else
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            fItems[fCount + i] = items[i];
+        }
+    }
+
+    fCount += count;
+
+    return true;
+}
+
 template <class T>
 T Array<T>::get(const int index)
 {
-    DISTRHO_SAFE_ASSERT(index >= 0 && index < fCount);
+    DISTRHO_SAFE_ASSERT_RETURN(index >= 0 && index < fCount, T());
 
     return fItems[index];
 }
@@ -84,14 +162,28 @@ bool Array<T>::empty()
 template <class T>
 void Array<T>::remove(const int index)
 {
-    DISTRHO_SAFE_ASSERT(index >= 0 && index < fCount);
+    removeRange(index, 1);
+}
+
+template <class T>
+void Array<T>::removeRange(const int index, const int count)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(index >= 0 && count >= 0 && index + count <= fCount, );
+
+    moveItems(&fItems[index], &fItems[index + count], fCount - index - count);
+
+    fCount -= count;
+}
+
+template <class T>
+void Array<T>::swapRemove(const int index)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(index >= 0 && index < fCount, );
 
     --fCount;
 
-    for (int i = index; i < fCount; ++i)
-    {
-        fItems[i] = fItems[i + 1];
-    }
+    if (index != fCount)
+        fItems[index] = std::move(fItems[fCount]);
 }
 
 template <class T>
@@ -103,7 +195,7 @@ void Array<T>::clear()
 template <class T>
 T Array<T>::getLast()
 {
-    DISTRHO_SAFE_ASSERT(!empty());
+    DISTRHO_SAFE_ASSERT_RETURN(!empty(), T());
 
     return fItems[fCount - 1];
 }
@@ -0,0 +1,74 @@
+#ifndef WOLF_ENVELOPE_CAPTURE_INCLUDED
+#define WOLF_ENVELOPE_CAPTURE_INCLUDED
+
+#include "src/DistrhoDefines.h"
+#include "extra/LeakDetector.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+START_NAMESPACE_DISTRHO
+
+/**
+ * Carries a decimated picture of a signal from the audio thread to the UI.
+ * The audio thread reduces every block of samples to the min, max and RMS of the signal,
+ * and queues these frames in a lock-free buffer which the UI drains at its own pace.
+ * One thread writes and one thread reads; when the UI falls behind, the newest frames are dropped.
+ */
+class EnvelopeCapture
+{
+public:
+  struct Frame
+  {
+    float min;
+    float max;
+    float rms;
+  };
+
+  /**
+   * @a capacity, in frames, is rounded up to a power of two.
+   */
+  explicit EnvelopeCapture(const int capacity = 256);
+  ~EnvelopeCapture();
+
+  /**
+   * How many samples make a frame. Not to be changed while processing.
+   */
+  void setDecimation(const int samplesPerFrame);
+
+  /**
+   * Audio thread: accumulate @a count samples, queueing a frame every samplesPerFrame samples.
+   * Never blocks nor allocates.
+   */
+  void process(const float *samples, const uint32_t count);
+
+  /**
+   * UI thread: take up to @a count of the oldest frames. Returns how many were taken.
+   */
+  int read(Frame *frames, const int count);
+
+private:
+  //lets the tests start the indices near their wraparound
+  friend struct EnvelopeCaptureTestAccess;
+
+  void pushFrame();
+
+  Frame *fFrames;
+  uint32_t fMask;
+
+  //free-running indices, masked when used
+  std::atomic<uint32_t> fWriteIndex;
+  std::atomic<uint32_t> fReadIndex;
+
+  int fSamplesPerFrame;
+  int fSamplesInFrame;
+  float fMin;
+  float fMax;
+  float fSumOfSquares;
+
+  DISTRHO_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EnvelopeCapture)
+};
+
+END_NAMESPACE_DISTRHO
+
+#endif
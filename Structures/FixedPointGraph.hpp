@@ -0,0 +1,49 @@
+#ifndef WOLF_FIXED_POINT_GRAPH_DEFINED_H
+#define WOLF_FIXED_POINT_GRAPH_DEFINED_H
+
+#include "src/DistrhoDefines.h"
+#include "Graph.hpp"
+
+#include <cstdint>
+
+START_NAMESPACE_DISTRHO
+
+namespace wolf
+{
+/**
+   * The number of intervals in the table of a fixed-point graph. Must be a power of two.
+   */
+const int fixedPointTableSize = 1024;
+
+/**
+ * A Q15 version of a graph, for targets without a fast FPU.
+ * The curve is sampled into a table with floating-point math when the graph changes,
+ * and evaluated with integer math only, using linear interpolation between the samples.
+ */
+class FixedPointGraph
+{
+public:
+  FixedPointGraph();
+
+  /**
+   * Sample the graph into the table. Uses floating-point math; call it when the graph changes, not per sample.
+   */
+  void bake(GraphBase &graph);
+
+  /**
+   * Get the Q15 y value at the Q15 value @a x.
+   */
+  int16_t getValueAt(int16_t x) const;
+
+  static int16_t toQ15(float value);
+  static float fromQ15(int16_t value);
+
+private:
+  int16_t fTable[fixedPointTableSize + 1];
+};
+
+} // namespace wolf
+
+END_NAMESPACE_DISTRHO
+
+#endif
@@ -2,15 +2,38 @@
 #define WOLF_GRAPH_DEFINED_H
 
 #include "src/DistrhoDefines.h"
+#include "Arena.hpp"
+
+#ifndef WOLF_GRAPH_MAX_VERTICES
+#define WOLF_GRAPH_MAX_VERTICES 99
+#endif
 
 START_NAMESPACE_DISTRHO
 
 namespace wolf
 {
 /**
-   * The max number of vertices that can be in the graph at the same time.
+   * The max number of vertices that can be in the default graph at the same time.
+   * Builds can change it by defining WOLF_GRAPH_MAX_VERTICES.
+   */
+const int maxVertices = WOLF_GRAPH_MAX_VERTICES;
+
+/**
+   * The number of cells in the grid used to find the segment which contains an x value.
+   * Must be a power of two.
+   */
+const int segmentGridSize = 64;
+
+/**
+   * Grid cells spanning up to this number of vertices are searched linearly instead of with a binary search.
+   */
+const int linearSearchMaxVertices = 16;
+
+/**
+   * The max length of a serialized vertex.
+   * format: x,y,tension,type;
    */
-const int maxVertices = 99;
+const int serializedVertexMaxLength = sizeof(char) * 256 + 4;
 
 enum CurveType
 {
@@ -31,12 +54,12 @@ enum WarpType
   SkewPlusMinus
 };
 
-class Graph;
+class GraphBase;
 
 class Vertex
 {
 public:
-  friend class Graph;
+  friend class GraphBase;
 
   float getX();
   float getY();
@@ -48,11 +71,11 @@ public:
   void setPosition(float x, float y);
   void setTension(float tension);
   void setType(CurveType type);
-  void setGraphPtr(Graph *graphPtr);
+  void setGraphPtr(GraphBase *graphPtr);
 
 protected:
   Vertex();
-  Vertex(float posX, float posY, float tension, CurveType type, Graph *graphPtr);
+  Vertex(float posX, float posY, float tension, CurveType type, GraphBase *graphPtr);
 
   float warpCoordinate(const float coordinate, const float warpAmount, const WarpType warpType) const;
   float unwarpCoordinate(float coordinate, const float warpAmount, const WarpType warpType) const;
@@ -71,14 +94,21 @@ private:
   WarpType graphVType;
   CurveType type;
 
-  Graph *graphPtr;
+  /**
+   * The integral of the graph from 0 to this vertex, cached by the graph.
+   */
+  double integral;
+
+  GraphBase *graphPtr;
 };
 
-class Graph
+/**
+ * The graph logic, independent of where the vertices are stored.
+ * Use StaticGraph or DynamicGraph to get an actual graph.
+ */
+class GraphBase
 {
 public:
-  Graph();
-
   void insertVertex(float x, float y, float tension = 0.0f, CurveType type = CurveType::SingleCurve);
   void removeVertex(int index);
   Vertex *getVertexAtIndex(int index);
@@ -90,12 +120,66 @@ public:
    */
   int getVertexCount();
 
-  static float getOutValue(float input, float tension, float p1x, float p1y, float p2x, float p2y, CurveType type);
+  /**
+   * Return the max number of vertices that the graph can contain.
+   */
+  int getVertexCapacity() const;
+
+  /**
+   * The evaluation functions are instantiated for float and double.
+   * All the math is done in the type of the input, without mixing precisions.
+   */
+  template <typename T>
+  static T getOutValue(T input, T tension, T p1x, T p1y, T p2x, T p2y, CurveType type);
 
   /**
    * Get the y value at x in the graph. 
    */
-  float getValueAt(float x);
+  template <typename T>
+  T getValueAt(T x);
+
+  /**
+   * Get the y value at x in the graph, starting the search at the segment found by the previous call.
+   * Faster than getValueAt(x) when x keeps increasing, like when rendering the curve.
+   * Start with a @a segmentHint of 0.
+   */
+  template <typename T>
+  T getValueAt(T x, int &segmentHint);
+
+  /**
+   * The integral from @a p1x to |@a input| of the positive side of the curve, and the slope of the curve at @a input.
+   * Analytic, except for the integral of a wave with a negative tension, which comes from a precomputed table.
+   */
+  template <typename T>
+  static T getOutIntegral(T input, T tension, T p1x, T p1y, T p2x, T p2y, CurveType type);
+
+  template <typename T>
+  static T getOutDerivative(T input, T tension, T p1x, T p1y, T p2x, T p2y, CurveType type);
+
+  /**
+   * How many features a curve with this tension has: the number of periods of a wave, the number of steps of stairs,
+   * the number of halves of a double curve, or 1. Lets renderers know how finely a segment must be sampled.
+   */
+  static float getCurveDetail(float tension, CurveType type);
+
+  /**
+   * Get the integral of the graph from 0 to x. Used for antiderivative anti-aliasing.
+   * Since the graph is odd, the antiderivative is even.
+   */
+  template <typename T>
+  T getAntiderivativeAt(T x);
+
+  /**
+   * Get the slope of the graph at x. At a vertex, the slope of the segment at its right is returned.
+   */
+  template <typename T>
+  T getDerivativeAt(T x);
+
+  /**
+   * Incremented whenever the shape of the graph changes.
+   * Lets the users of getAntiderivativeAt() know when the values they kept are stale.
+   */
+  unsigned int getRevision() const;
 
   /**
    * Empty the graph.
@@ -132,9 +216,46 @@ public:
    */
   void rebuildFromString(const char *serializedGraph);
 
+protected:
+  /**
+   * The storage must hold @a capacity vertices, and the serialization buffer must hold
+   * serializedVertexMaxLength * @a capacity + 1 characters.
+   */
+  GraphBase(void *vertexStorage, char *serializationBuffer, int capacity);
+  ~GraphBase();
+
+  /**
+   * Copy the state of another graph into this one. Extra vertices are dropped if this graph is smaller.
+   */
+  void copyFrom(const GraphBase &graph);
+
 private:
-  Vertex vertices[maxVertices];
+  friend class Vertex;
+
+  /**
+   * Must be called when the horizontal position of the vertices changes.
+   */
+  void invalidateSegmentGrid();
+  void rebuildSegmentGrid();
+
+  /**
+   * Must be called when the shape of the graph changes.
+   */
+  void invalidateIntegrals();
+  void rebuildIntegrals();
+
+  /**
+   * Return the index of the vertex at the left of the segment which contains @a x.
+   */
+  template <typename T>
+  int findSegment(T x);
+
+  template <typename T>
+  T getValueInSegment(T x, T absX, int segment);
+
+  Vertex *vertices;
   int vertexCount;
+  const int capacity;
 
   float horizontalWarpAmount;
   float verticalWarpAmount;
@@ -144,10 +265,90 @@ private:
 
   bool bipolarMode;
 
-  //format: x,y,tension,type;
-  char serializationBuffer[(sizeof(char) * 256 + 4) * maxVertices + 1];
+  char *serializationBuffer;
+
+  /**
+   * Maps floor(x * segmentGridSize) to the segment which contains the left side of the cell.
+   * Rebuilt lazily after an edit.
+   */
+  int segmentGrid[segmentGridSize + 1];
+  bool segmentGridDirty;
+
+  bool integralsDirty;
+  unsigned int revision;
+
+  DISTRHO_DECLARE_NON_COPYABLE(GraphBase)
 };
 
+/**
+ * Storage for the vertices of a StaticGraph.
+ * It's a separate base class so that it gets constructed before GraphBase.
+ */
+template <int Capacity>
+struct StaticGraphStorage
+{
+  alignas(Vertex) unsigned char storedVertices[sizeof(Vertex) * Capacity];
+  char storedSerializationBuffer[serializedVertexMaxLength * Capacity + 1];
+};
+
+/**
+ * A graph which can contain up to @a Capacity vertices, stored inline.
+ */
+template <int Capacity>
+class StaticGraph : private StaticGraphStorage<Capacity>,
+                    public GraphBase
+{
+public:
+  static const int vertexCapacity = Capacity;
+
+  StaticGraph();
+  StaticGraph(const StaticGraph &graph);
+
+  StaticGraph &operator=(const StaticGraph &graph);
+};
+
+template <int Capacity>
+StaticGraph<Capacity>::StaticGraph() : StaticGraphStorage<Capacity>(),
+                                       GraphBase(this->storedVertices, this->storedSerializationBuffer, Capacity)
+{
+}
+
+template <int Capacity>
+StaticGraph<Capacity>::StaticGraph(const StaticGraph &graph) : StaticGraphStorage<Capacity>(),
+                                                               GraphBase(this->storedVertices, this->storedSerializationBuffer, Capacity)
+{
+    copyFrom(graph);
+}
+
+template <int Capacity>
+StaticGraph<Capacity> &StaticGraph<Capacity>::operator=(const StaticGraph &graph)
+{
+    if (this != &graph)
+        copyFrom(graph);
+
+    return *this;
+}
+
+/**
+ * A graph whose capacity is chosen at runtime. The vertices are allocated from an arena,
+ * which must outlive the graph. If the arena is full, the graph has no capacity and is an identity.
+ */
+class DynamicGraph : public GraphBase
+{
+public:
+  DynamicGraph(Arena &arena, int capacity);
+
+private:
+  DynamicGraph(void *storage, int capacity);
+
+  DISTRHO_DECLARE_NON_COPYABLE(DynamicGraph)
+};
+
+/**
+ * The default graph.
+ */
+typedef StaticGraph<maxVertices> Graph;
+
 } // namespace wolf
 
 END_NAMESPACE_DISTRHO
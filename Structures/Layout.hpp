@@ -45,7 +45,7 @@ class LayoutItem
 public:
 	LayoutItem(Layout *parent, Widget *widget);
 
-	Widget *getWidget();
+	Widget *getWidget() const;
 
 	LayoutItem &setAnchors(int anchors);
 	LayoutItem &setAnchors(Anchors anchors);
@@ -63,6 +63,14 @@ public:
 
 	RelativePosition getRelativePos();
 
+	/**
+	 * How much of the free space of a FlexLayout the item takes, and how much it gives back when space is lacking.
+	 */
+	LayoutItem &setFlex(const float grow, const float shrink = 1.0f);
+
+	float getGrow();
+	float getShrink();
+
 private:
 	Widget *fWidget;
 	Layout *fParent;
@@ -71,6 +79,9 @@ private:
 	// the absolute distance of the item from the sides of the layout
 	RelativePosition fRelativePos;
 
+	float fGrow;
+	float fShrink;
+
 	DISTRHO_LEAK_DETECTOR(LayoutItem);
 };
 
@@ -86,8 +97,21 @@ public:
 	LayoutItem *getLastItem();
 
 protected:
+	friend class LayoutItem;
+
 	virtual void onItemAdded(const LayoutItem &item);
+	virtual void onItemChanged(const LayoutItem &item);
+	virtual void onItemResized(const LayoutItem &item);
+
+	/**
+	 * Move and resize the widgets to fGeometry, which holds one absolute rectangle per item.
+	 * A layout computes all of its geometry first, then applies it here in one pass:
+	 * only the widgets whose rectangle changed get an event, and a single one for their position and for their size.
+	 */
+	void applyGeometry();
+
 	std::vector<LayoutItem> fItems;
+	std::vector<DGL_NAMESPACE::Rectangle<int>> fGeometry;
 
 private:
 	DISTRHO_LEAK_DETECTOR(Layout);
@@ -124,4 +148,72 @@ private:
 	DISTRHO_LEAK_DETECTOR(StackLayout);
 };
 
+/**
+ * Lays its items out in rows or columns, like a CSS flexbox.
+ * The size of an item's widget is its basis, which then grows or shrinks along the main axis according to its flex factors.
+ * The basis is measured when the item is first laid out, and again whenever the item is resized with LayoutItem::setSize(),
+ * or its widget is resized directly to anything else than what the layout gave it.
+ * Changing the layout or its items only marks it dirty: call relayout() once done.
+ * A relayout computes the whole container, but only the widgets whose geometry changed are resized,
+ * so nested layouts are only laid out again when their own size changes.
+ */
+class FlexLayout : public Layout
+{
+public:
+	enum Direction
+	{
+		Row,
+		Column
+	};
+
+	enum Alignment
+	{
+		Start,
+		Center,
+		End,
+		Stretch,	 //cross axis only
+		SpaceBetween //main axis only
+	};
+
+	FlexLayout(Widget *parent);
+	FlexLayout(Window &parent);
+
+	void setDirection(Direction direction);
+	void setWrap(bool wrap);
+	void setGap(int gap);
+	void setJustifyContent(Alignment alignment);
+	void setAlignItems(Alignment alignment);
+
+	/**
+	 * Lay the items out again, if anything changed since the last time.
+	 */
+	void relayout();
+
+protected:
+	void onItemAdded(const LayoutItem &item) override;
+	void onItemChanged(const LayoutItem &item) override;
+	void onItemResized(const LayoutItem &item) override;
+
+	void onResize(const ResizeEvent &ev) override;
+	void onPositionChanged(const PositionChangedEvent &ev) override;
+	void onDisplay() override;
+
+private:
+	void measureItems();
+	void layoutLine(size_t first, size_t last, float mainSize, float crossPosition, float crossSize);
+
+	Direction fDirection;
+	bool fWrap;
+	int fGap;
+	Alignment fJustifyContent;
+	Alignment fAlignItems;
+
+	//the size the widgets were given, which growing or shrinking doesn't change
+	std::vector<Size<uint>> fBasis;
+
+	bool fDirty;
+
+	DISTRHO_LEAK_DETECTOR(FlexLayout);
+};
+
 END_NAMESPACE_DISTRHO
@@ -1,69 +1,334 @@
-#include "Stack.hpp"
-
 #ifndef WOLF_OBJECT_POOL_H_INCLUDED
 #define WOLF_OBJECT_POOL_H_INCLUDED
 
+#include "src/DistrhoDefines.h"
+
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 START_NAMESPACE_DISTRHO
 
 namespace wolf
 {
+/**
+ * A pool of objects constructed up front, in contiguous chunks of storage.
+ * Free objects are linked through their slot, so taking and giving back an object is a pointer swap.
+ * Objects given back are reset() if they have such a method, and are only destructed with the pool.
+ * The pool owns all of its objects, including the ones taken out: they must never be deleted,
+ * and they are destructed along with the others when the pool is.
+ * The pool isn't synchronized: all its methods must be called from the same thread.
+ */
 template <class T>
 class ObjectPool
 {
   public:
+    enum GrowthPolicy
+    {
+      /**
+       * getObject() returns nullptr when the pool is empty. Safe on the audio thread.
+       */
+      FixedCapacity,
+
+      /**
+       * getObject() adds a chunk of objects when the pool is empty. Not for the audio thread:
+       * a real-time user should keep FixedCapacity, and reserve() what it needs before processing starts.
+       */
+      GrowInChunks
+    };
+
+    /**
+     * Gives its object back to the pool when destroyed.
+     */
+    class Handle
+    {
+      public:
+        Handle();
+        Handle(Handle &&other);
+        ~Handle();
+
+        Handle &operator=(Handle &&other);
+
+        T *get() const;
+        T *operator->() const;
+        T &operator*() const;
+
+        explicit operator bool() const;
+
+        void release();
+
+      private:
+        friend class ObjectPool;
+
+        Handle(ObjectPool *pool, T *object);
+
+        ObjectPool *fPool;
+        T *fObject;
+
+        Handle(const Handle &) = delete;
+        Handle &operator=(const Handle &) = delete;
+    };
+
+    /**
+     * Construct @a numberOfObjects objects with @a args, and the objects of the later chunks the same way.
+     * A chunk holds at least one object.
+     */
     template <typename... Args>
     ObjectPool(int numberOfObjects, Args &&... args);
+
+    template <typename... Args>
+    ObjectPool(GrowthPolicy growthPolicy, int chunkSize, Args &&... args);
+
     ~ObjectPool();
 
+    /**
+     * Take a free object, or nullptr if there is none left and the pool can't grow.
+     */
     T *getObject();
     void freeObject(T *object);
 
+    Handle acquire();
+
+    /**
+     * Add chunks until at least @a numberOfObjects objects are free.
+     * It allocates, so it must not run while the audio thread uses the pool.
+     */
+    void reserve(int numberOfObjects);
+
     int numberObjectsLeft();
+    int getCapacity();
 
   private:
-    wolf::Stack<T *> objects;
+    struct Slot
+    {
+        //first, so that the address of the object is the address of its slot
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        Slot *nextFree;
+    };
+
+    template <typename U>
+    static auto resetObject(U *object, int) -> decltype(object->reset(), void())
+    {
+        object->reset();
+    }
+
+    template <typename U>
+    static void resetObject(U *, long)
+    {
+    }
+
+    void addChunk(int numberOfObjects);
+
+    const GrowthPolicy fGrowthPolicy;
+    const int fChunkSize;
+    std::function<void(void *)> fConstruct;
+
+    std::vector<Slot *> fChunks;
+    std::vector<int> fChunkSizes;
+
+    Slot *fFreeList;
+    int fFreeCount;
+    int fCapacity;
+
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
 };
 
 template <class T>
 template <typename... Args>
-ObjectPool<T>::ObjectPool(int numberOfObjects, Args &&... args) : objects(numberOfObjects)
+ObjectPool<T>::ObjectPool(int numberOfObjects, Args &&... args) : ObjectPool(FixedCapacity, numberOfObjects, std::forward<Args>(args)...)
+{
+}
+
+template <class T>
+template <typename... Args>
+ObjectPool<T>::ObjectPool(GrowthPolicy growthPolicy, int chunkSize, Args &&... args) : fGrowthPolicy(growthPolicy),
+                                                                                        fChunkSize(chunkSize > 0 ? chunkSize : 1),
+                                                                                        fConstruct([args...](void *storage) { new (storage) T(args...); }),
+                                                                                        fFreeList(nullptr),
+                                                                                        fFreeCount(0),
+                                                                                        fCapacity(0)
 {
-    for (int i = 0; i < objects.getSize(); ++i)
+    //an empty chunk would make the pool unable to grow, and reserve() loop forever
+    DISTRHO_SAFE_ASSERT(chunkSize > 0);
+
+    addChunk(fChunkSize);
+}
+
+template <class T>
+ObjectPool<T>::~ObjectPool()
+{
+    for (size_t i = 0; i < fChunks.size(); ++i)
     {
-        this->objects.push(new T(args...));
+        for (int j = 0; j < fChunkSizes[i]; ++j)
+        {
+            reinterpret_cast<T *>(&fChunks[i][j].storage)->~T();
+        }
+
+        delete[] fChunks[i];
     }
 }
 
 template <class T>
-ObjectPool<T>::~ObjectPool()
-{    
-    while (objects.getCount() > 0)
+void ObjectPool<T>::addChunk(int numberOfObjects)
+{
+    if (numberOfObjects <= 0)
+        return;
+
+    Slot *chunk = new Slot[numberOfObjects];
+
+    fChunks.push_back(chunk);
+    fChunkSizes.push_back(numberOfObjects);
+
+    //linked backwards, so that the objects are handed out in the order of their storage
+    for (int i = numberOfObjects; i-- > 0;)
     {
-        delete this->objects.pop();
+        fConstruct(&chunk[i].storage);
+
+        chunk[i].nextFree = fFreeList;
+        fFreeList = &chunk[i];
     }
+
+    fFreeCount += numberOfObjects;
+    fCapacity += numberOfObjects;
 }
 
 template <class T>
 T *ObjectPool<T>::getObject()
 {
-    return this->objects.pop();
+    if (fFreeList == nullptr && fGrowthPolicy == GrowInChunks)
+        addChunk(fChunkSize);
+
+    if (fFreeList == nullptr)
+        return nullptr;
+
+    Slot *slot = fFreeList;
+
+    fFreeList = slot->nextFree;
+    --fFreeCount;
+
+    return reinterpret_cast<T *>(&slot->storage);
 }
 
 template <class T>
 void ObjectPool<T>::freeObject(T *object)
 {
-    object->reset();
+    if (object == nullptr)
+        return;
 
-    this->objects.push(object);
+    resetObject(object, 0);
+
+    Slot *slot = reinterpret_cast<Slot *>(object);
+
+    slot->nextFree = fFreeList;
+    fFreeList = slot;
+    ++fFreeCount;
+}
+
+template <class T>
+typename ObjectPool<T>::Handle ObjectPool<T>::acquire()
+{
+    return Handle(this, getObject());
+}
+
+template <class T>
+void ObjectPool<T>::reserve(int numberOfObjects)
+{
+    while (fFreeCount < numberOfObjects)
+    {
+        addChunk(fChunkSize);
+    }
 }
 
 template <class T>
 int ObjectPool<T>::numberObjectsLeft()
 {
-    return this->objects.getCount();
+    return fFreeCount;
+}
+
+template <class T>
+int ObjectPool<T>::getCapacity()
+{
+    return fCapacity;
+}
+
+template <class T>
+ObjectPool<T>::Handle::Handle() : fPool(nullptr),
+                                  fObject(nullptr)
+{
+}
+
+template <class T>
+ObjectPool<T>::Handle::Handle(ObjectPool *pool, T *object) : fPool(pool),
+                                                             fObject(object)
+{
+}
+
+template <class T>
+ObjectPool<T>::Handle::Handle(Handle &&other) : fPool(other.fPool),
+                                                fObject(other.fObject)
+{
+    other.fObject = nullptr;
+}
+
+template <class T>
+ObjectPool<T>::Handle::~Handle()
+{
+    release();
+}
+
+template <class T>
+typename ObjectPool<T>::Handle &ObjectPool<T>::Handle::operator=(Handle &&other)
+{
+    if (this != &other)
+    {
+        release();
+
+        fPool = other.fPool;
+        fObject = other.fObject;
+        other.fObject = nullptr;
+    }
+
+    return *this;
+}
+
+template <class T>
+T *ObjectPool<T>::Handle::get() const
+{
+    return fObject;
+}
+
+template <class T>
+T *ObjectPool<T>::Handle::operator->() const
+{
+    return fObject;
+}
+
+template <class T>
+T &ObjectPool<T>::Handle::operator*() const
+{
+    return *fObject;
+}
+
+template <class T>
+ObjectPool<T>::Handle::operator bool() const
+{
+    return fObject != nullptr;
+}
+
+template <class T>
+void ObjectPool<T>::Handle::release()
+{
+    if (fObject == nullptr)
+        return;
+
+    fPool->freeObject(fObject);
+    fObject = nullptr;
 }
 }
 
 END_NAMESPACE_DISTRHO
 
-#endif
\ No newline at end of file
+#endif
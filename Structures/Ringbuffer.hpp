@@ -1,58 +1,179 @@
 #ifndef RINGBUFFER_H
 #define RINGBUFFER_H
 
-#include <stdexcept>
+#include <cstring>
+#include <new>
+#include <type_traits>
 #include "src/DistrhoDefines.h"
+#include "Arena.hpp"
 
 START_NAMESPACE_DISTRHO
 
 namespace wolf
 {
 
+/**
+ * A FIFO of fixed capacity, rounded up to a power of two so that wrapping around is a mask.
+ * It also serves as a history or a delay line: getHistory() and getInterpolatedHistory() read back
+ * from the newest item, without removing anything.
+ */
 template <class T>
 class Ringbuffer
 {
   public:
-    explicit Ringbuffer(const int size);
+    enum OverflowPolicy
+    {
+      /**
+       * Adding to a full buffer drops its oldest items, like a history does.
+       */
+      Overwrite,
+
+      /**
+       * Adding to a full buffer fails, like a queue does.
+       */
+      Reject
+    };
+
+    explicit Ringbuffer(const int size, const OverflowPolicy policy = Overwrite);
+
+    /**
+     * Take the storage of the buffer from @a arena, instead of the heap.
+     */
+    Ringbuffer(Arena &arena, const int size, const OverflowPolicy policy = Overwrite);
     ~Ringbuffer();
 
-    void add(const T item);
+    bool add(const T item);
     T get();
     T peek(const int distance);
     void clear();
 
+    /**
+     * Add @a count items, in at most two copies. Returns how many were added.
+     */
+    int push(const T *items, const int count);
+
+    /**
+     * Take up to @a count of the oldest items, in at most two copies. Returns how many were taken.
+     */
+    int pop(T *items, const int count);
+
+    /**
+     * The item added @a age items ago: 0 is the newest.
+     */
+    T getHistory(const int age);
+
+    /**
+     * The history at a fractional @a age, linearly interpolated, for reading a delay line between samples.
+     */
+    T getInterpolatedHistory(const float age);
+
     int count();
+    int capacity();
     bool full();
     bool empty();
 
   private:
+    static int nextPowerOfTwo(const int value);
+
+    void copyIn(const int index, const T *items, const int count);
+    void copyOut(T *items, const int index, const int count);
+
     int fCount;
+    int fCapacity;
+    int fMask;
     T *fItems;
-    const int fCapacity;
     int fStart;
-    int fEnd;
+    const OverflowPolicy fPolicy;
+    const bool fOwnsItems;
 };
 
 template <class T>
-Ringbuffer<T>::Ringbuffer(const int capacity) : fCount(0),
-                                                fItems(new T[capacity]),
-                                                fCapacity(capacity),
-                                                fStart(0),
-                                                fEnd(-1)
+int Ringbuffer<T>::nextPowerOfTwo(const int value)
+{
+    int powerOfTwo = 1;
+
+    while (powerOfTwo < value)
+    {
+        powerOfTwo <<= 1;
+    }
+
+    return powerOfTwo;
+}
+
+template <class T>
+Ringbuffer<T>::Ringbuffer(const int capacity, const OverflowPolicy policy) : fCount(0),
+                                                                             fCapacity(nextPowerOfTwo(capacity)),
+                                                                             fMask(fCapacity - 1),
+                                                                             fItems(new T[fCapacity]),
+                                                                             fStart(0),
+                                                                             fPolicy(policy),
+                                                                             fOwnsItems(true)
 {
 }
 
+template <class T>
+Ringbuffer<T>::Ringbuffer(Arena &arena, const int capacity, const OverflowPolicy policy) : fCount(0),
+                                                                                           fCapacity(nextPowerOfTwo(capacity)),
+                                                                                           fMask(fCapacity - 1),
+                                                                                           fItems(arena.allocateArray<T>(fCapacity)),
+                                                                                           fStart(0),
+                                                                                           fPolicy(policy),
+                                                                                           fOwnsItems(false)
+{
+    if (fItems == nullptr)
+    {
+        //a full arena leaves an empty buffer, which rejects everything rather than writing through null
+        fCapacity = 0;
+        fMask = 0;
+    }
+
+    DISTRHO_SAFE_ASSERT_RETURN(fItems != nullptr, );
+
+    for (int i = 0; i < fCapacity; ++i)
+    {
+        new (&fItems[i]) T();
+    }
+}
+
 template <class T>
 Ringbuffer<T>::~Ringbuffer()
 {
-    delete[] fItems;
+    if (fOwnsItems)
+    {
+        delete[] fItems;
+        return;
+    }
+
+    if (fItems == nullptr)
+        return;
+
+    //the arena owns the memory, but not the objects in it
+    for (int i = 0; i < fCapacity; ++i)
+    {
+        fItems[i].~T();
+    }
 }
 
 template <class T>
-void Ringbuffer<T>::add(const T value)
+bool Ringbuffer<T>::add(const T value)
 {
+    if (fCapacity == 0)
+        return false;
+
+    if (full())
+    {
+        if (fPolicy == Reject)
+            return false;
+
+        //drop the oldest item
+        fStart = (fStart + 1) & fMask;
+        --fCount;
+    }
+
+    fItems[(fStart + fCount) & fMask] = value;
     ++fCount;
-    fItems[++fEnd % fCapacity] = value;
+
+    return true;
 }
 
 template <class T>
@@ -60,26 +181,145 @@ void Ringbuffer<T>::clear()
 {
     fCount = 0;
     fStart = 0;
-    fEnd = -1;
 }
 
 template <class T>
 T Ringbuffer<T>::get()
 {
-    DISTRHO_SAFE_ASSERT(!empty());
+    DISTRHO_SAFE_ASSERT_RETURN(!empty(), T());
+
+    const T item = fItems[fStart];
 
+    fStart = (fStart + 1) & fMask;
     --fCount;
-    return fItems[fStart++ % fCapacity];
+
+    return item;
 }
 
 template <class T>
 T Ringbuffer<T>::peek(const int distance)
 {
-    DISTRHO_SAFE_ASSERT(distance >= 0);
-    DISTRHO_SAFE_ASSERT(!empty());
-    DISTRHO_SAFE_ASSERT(distance < count() || full());
+    DISTRHO_SAFE_ASSERT_RETURN(distance >= 0 && distance < fCount, T());
+
+    return fItems[(fStart + distance) & fMask];
+}
+
+template <class T>
+void Ringbuffer<T>::copyIn(const int index, const T *items, const int count)
+{
+    if (std::is_trivially_copyable<T>::value)
+    {
+        std::memcpy(static_cast<void *>(&fItems[index]), static_cast<const void *>(items), sizeof(T) * count);
+        return;
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        fItems[index + i] = items[i];
+    }
+}
+
+template <class T>
+void Ringbuffer<T>::copyOut(T *items, const int index, const int count)
+{
+    if (std::is_trivially_copyable<T>::value)
+    {
+        std::memcpy(static_cast<void *>(items), static_cast<const void *>(&fItems[index]), sizeof(T) * count);
+        return;
+    }
 
-    return fItems[(fStart + distance) % fCapacity];
+    for (int i = 0; i < count; ++i)
+    {
+        items[i] = fItems[index + i];
+    }
+}
+
+template <class T>
+int Ringbuffer<T>::push(const T *items, int count)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(count >= 0, 0);
+
+    if (fCapacity == 0)
+        return 0;
+
+    const int freeSpace = fCapacity - fCount;
+
+    if (count > freeSpace)
+    {
+        if (fPolicy == Reject)
+        {
+            count = freeSpace;
+        }
+        else
+        {
+            //only the newest items survive, so skip the ones which would be overwritten anyway
+            if (count > fCapacity)
+            {
+                items += count - fCapacity;
+                count = fCapacity;
+            }
+
+            const int dropped = count - freeSpace;
+
+            fStart = (fStart + dropped) & fMask;
+            fCount -= dropped;
+        }
+    }
+
+    const int end = (fStart + fCount) & fMask;
+    const int firstSpan = count < fCapacity - end ? count : fCapacity - end;
+
+    copyIn(end, items, firstSpan);
+    copyIn(0, items + firstSpan, count - firstSpan);
+
+    fCount += count;
+
+    return count;
+}
+
+template <class T>
+int Ringbuffer<T>::pop(T *items, int count)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(count >= 0, 0);
+
+    if (count > fCount)
+        count = fCount;
+
+    const int firstSpan = count < fCapacity - fStart ? count : fCapacity - fStart;
+
+    copyOut(items, fStart, firstSpan);
+    copyOut(items + firstSpan, 0, count - firstSpan);
+
+    fStart = (fStart + count) & fMask;
+    fCount -= count;
+
+    return count;
+}
+
+template <class T>
+T Ringbuffer<T>::getHistory(const int age)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(age >= 0 && age < fCount, T());
+
+    return fItems[(fStart + fCount - 1 - age) & fMask];
+}
+
+template <class T>
+T Ringbuffer<T>::getInterpolatedHistory(const float age)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(age >= 0.0f && age <= fCount - 1, T());
+
+    const int newer = (int)age;
+    const float fraction = age - newer;
+
+    //the oldest item has nothing older to blend with
+    if (fraction == 0.0f)
+        return getHistory(newer);
+
+    const T a = fItems[(fStart + fCount - 1 - newer) & fMask];
+    const T b = fItems[(fStart + fCount - 2 - newer) & fMask];
+
+    return a + (b - a) * fraction;
 }
 
 template <class T>
@@ -88,6 +328,12 @@ int Ringbuffer<T>::count()
     return fCount;
 }
 
+template <class T>
+int Ringbuffer<T>::capacity()
+{
+    return fCapacity;
+}
+
 template <class T>
 bool Ringbuffer<T>::full()
 {
@@ -104,4 +350,4 @@ bool Ringbuffer<T>::empty()
 
 END_NAMESPACE_DISTRHO
 
-#endif
\ No newline at end of file
+#endif
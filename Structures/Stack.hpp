@@ -1,4 +1,7 @@
 #include <cassert>
+#include <new>
+
+#include "Arena.hpp"
 
 #ifndef WOLF_STACK_H_INCLUDED
 #define WOLF_STACK_H_INCLUDED
@@ -13,6 +16,11 @@ class Stack
 {
   public:
     Stack(int size);
+
+    /**
+     * Take the storage of the stack from @a arena, instead of the heap.
+     */
+    Stack(Arena &arena, int size);
     ~Stack();
 
     void push(T item);
@@ -25,6 +33,7 @@ class Stack
     T *items;
     int count;
     int size;
+    bool ownsItems;
 };
 
 template <class T>
@@ -33,18 +42,45 @@ Stack<T>::Stack(int size)
     this->items = new T[size];
     this->size = size;
     this->count = 0;
+    this->ownsItems = true;
+};
+
+template <class T>
+Stack<T>::Stack(Arena &arena, int size)
+{
+    this->items = arena.allocateArray<T>(size);
+    this->size = this->items != nullptr ? size : 0;
+    this->count = 0;
+    this->ownsItems = false;
+
+    DISTRHO_SAFE_ASSERT(this->items != nullptr);
+
+    for (int i = 0; i < this->size; ++i)
+    {
+        new (&this->items[i]) T();
+    }
 };
 
 template <class T>
 Stack<T>::~Stack()
 {
-    delete[] items;
+    if (ownsItems)
+    {
+        delete[] items;
+        return;
+    }
+
+    //the arena owns the memory, but not the objects in it
+    for (int i = 0; i < size; ++i)
+    {
+        items[i].~T();
+    }
 };
 
 template <class T>
 void Stack<T>::push(T item)
 {
-    DISTRHO_SAFE_ASSERT(count < size);
+    DISTRHO_SAFE_ASSERT_RETURN(count < size, );
 
     items[count++] = item;
 }
@@ -52,7 +88,7 @@ void Stack<T>::push(T item)
 template <class T>
 T Stack<T>::pop()
 {
-    DISTRHO_SAFE_ASSERT(count > 0);
+    DISTRHO_SAFE_ASSERT_RETURN(count > 0, T());
 
     return items[--count];
 }
@@ -60,7 +96,7 @@ T Stack<T>::pop()
 template <class T>
 T Stack<T>::peek()
 {
-    DISTRHO_SAFE_ASSERT(count > 0);
+    DISTRHO_SAFE_ASSERT_RETURN(count > 0, T());
 
     return items[count - 1];
 }
@@ -0,0 +1,312 @@
+#ifndef WOLF_STATIC_ARRAY_H_INCLUDED
+#define WOLF_STATIC_ARRAY_H_INCLUDED
+
+#include "src/DistrhoDefines.h"
+
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+START_NAMESPACE_DISTRHO
+
+namespace wolf
+{
+/**
+ * Move @a count items from @a source to @a target, which may overlap.
+ * Trivially copyable items are moved as bytes, the others one by one in the direction which doesn't overwrite them.
+ * @a target must hold constructed items.
+ */
+template <class T>
+void moveItems(T *target, T *source, const int count)
+{
+    if (count <= 0 || target == source)
+        return;
+
+    if (std::is_trivially_copyable<T>::value)
+    {
+        std::memmove(static_cast<void *>(target), static_cast<const void *>(source), sizeof(T) * count);
+        return;
+    }
+
+    if (target < source)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            target[i] = std::move(source[i]);
+        }
+    }
+    else
+    {
+        for (int i = count; i-- > 0;)
+        {
+            target[i] = std::move(source[i]);
+        }
+    }
+}
+
+/**
+ * An array of at most N items, stored inline: it never allocates, and lives wherever its owner does.
+ * Items are only constructed when added, so they needn't be default-constructible, and may be move-only.
+ * Adding to a full array asserts and does nothing. get() returns nullptr out of bounds, while operator[] doesn't check in release builds.
+ */
+template <class T, int N>
+class StaticArray
+{
+  public:
+    StaticArray();
+    ~StaticArray();
+
+    bool add(const T &item);
+    bool add(T &&item);
+
+    template <typename... Args>
+    T *emplace(Args &&... args);
+
+    /**
+     * Add @a count items copied from @a items, or none if they don't fit.
+     */
+    bool addRange(const T *items, const int count);
+
+    /**
+     * The item at @a index, or nullptr if there is none.
+     */
+    T *get(const int index);
+    T *getLast();
+    T &operator[](const int index);
+
+    T pop();
+
+    /**
+     * Remove the item at @a index, keeping the order of the others.
+     */
+    void remove(const int index);
+    void removeRange(const int index, const int count);
+
+    /**
+     * Remove the item at @a index by moving the last one in its place. Constant time, but doesn't keep the order.
+     */
+    void swapRemove(const int index);
+
+    void removeFirstMatchingValue(const T &value);
+    void clear();
+
+    int count() const;
+    int capacity() const;
+    bool full() const;
+    bool empty() const;
+
+    T *begin();
+    T *end();
+
+  private:
+    T *items();
+
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type fStorage[N];
+    int fCount;
+
+    StaticArray(const StaticArray &) = delete;
+    StaticArray &operator=(const StaticArray &) = delete;
+};
+
+template <class T, int N>
+StaticArray<T, N>::StaticArray() : fCount(0)
+{
+}
+
+template <class T, int N>
+StaticArray<T, N>::~StaticArray()
+{
+    clear();
+}
+
+template <class T, int N>
+T *StaticArray<T, N>::items()
+{
+    return reinterpret_cast<T *>(fStorage);
+}
+
+template <class T, int N>
+bool StaticArray<T, N>::add(const T &item)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(!full(), false);
+
+    new (&items()[fCount++]) T(item);
+
+    return true;
+}
+
+template <class T, int N>
+bool StaticArray<T, N>::add(T &&item)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(!full(), false);
+
+    new (&items()[fCount++]) T(std::move(item));
+
+    return true;
+}
+
+template <class T, int N>
+template <typename... Args>
+T *StaticArray<T, N>::emplace(Args &&... args)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(!full(), nullptr);
+
+    return new (&items()[fCount++]) T(std::forward<Args>(args)...);
+}
+
+template <class T, int N>
+bool StaticArray<T, N>::addRange(const T *source, const int count)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(count >= 0 && fCount + count <= N, false);
+
+    if (std::is_trivially_copyable<T>::value)
+    {
+        std::memcpy(static_cast<void *>(&items()[fCount]), static_cast<const void *>(source), sizeof(T) * count);
+        fCount += count;
+
+        return true;
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        new (&items()[fCount++]) T(source[i]);
+    }
+
+    return true;
+}
+
+template <class T, int N>
+T *StaticArray<T, N>::get(const int index)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(index >= 0 && index < fCount, nullptr);
+
+    return &items()[index];
+}
+
+template <class T, int N>
+T *StaticArray<T, N>::getLast()
+{
+    return get(fCount - 1);
+}
+
+template <class T, int N>
+T &StaticArray<T, N>::operator[](const int index)
+{
+    //there's no item to hand out a reference to, so this can't fail softly like get()
+    assert(index >= 0 && index < fCount);
+
+    return items()[index];
+}
+
+template <class T, int N>
+T StaticArray<T, N>::pop()
+{
+    DISTRHO_SAFE_ASSERT_RETURN(!empty(), T());
+
+    T item = std::move(items()[fCount - 1]);
+    items()[--fCount].~T();
+
+    return item;
+}
+
+template <class T, int N>
+void StaticArray<T, N>::remove(const int index)
+{
+    removeRange(index, 1);
+}
+
+template <class T, int N>
+void StaticArray<T, N>::removeRange(const int index, const int count)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(index >= 0 && count >= 0 && index + count <= fCount, );
+
+    moveItems(&items()[index], &items()[index + count], fCount - index - count);
+
+    for (int i = fCount - count; i < fCount; ++i)
+    {
+        items()[i].~T();
+    }
+
+    fCount -= count;
+}
+
+template <class T, int N>
+void StaticArray<T, N>::swapRemove(const int index)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(index >= 0 && index < fCount, );
+
+    --fCount;
+
+    if (index != fCount)
+        items()[index] = std::move(items()[fCount]);
+
+    items()[fCount].~T();
+}
+
+template <class T, int N>
+void StaticArray<T, N>::removeFirstMatchingValue(const T &value)
+{
+    for (int i = 0; i < fCount; ++i)
+    {
+        if (items()[i] == value)
+        {
+            remove(i);
+            return;
+        }
+    }
+}
+
+template <class T, int N>
+void StaticArray<T, N>::clear()
+{
+    for (int i = 0; i < fCount; ++i)
+    {
+        items()[i].~T();
+    }
+
+    fCount = 0;
+}
+
+template <class T, int N>
+int StaticArray<T, N>::count() const
+{
+    return fCount;
+}
+
+template <class T, int N>
+int StaticArray<T, N>::capacity() const
+{
+    return N;
+}
+
+template <class T, int N>
+bool StaticArray<T, N>::full() const
+{
+    return fCount == N;
+}
+
+template <class T, int N>
+bool StaticArray<T, N>::empty() const
+{
+    return fCount == 0;
+}
+
+template <class T, int N>
+T *StaticArray<T, N>::begin()
+{
+    return items();
+}
+
+template <class T, int N>
+T *StaticArray<T, N>::end()
+{
+    return items() + fCount;
+}
+
+} // namespace wolf
+
+END_NAMESPACE_DISTRHO
+
+#endif
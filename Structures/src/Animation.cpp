@@ -5,242 +5,174 @@
 #include "Geometry.hpp"
 #include "Widget.hpp"
 
-#include <chrono>
+#include <utility>
 
 START_NAMESPACE_DISTRHO
 
-Animation::Animation(float duration, EasingFunction easingFunction) : fDuration(duration),
-																	  fCurrentTime(0.0f),
-																	  fSpeed(1.0f),
-																	  fTimeLastRun(std::chrono::steady_clock::now()),
-																	  fPlaybackDirection(Forward),
-																	  fRepeatMode(NoRepeat),
-																	  fEasingFunction(easingFunction),
-																	  fIsPlaying(false)
-
-{
-}
-
-Animation::~Animation()
+Animation::Animation() : fEngine(),
+						 fTrack(-1)
 {
 }
 
-void Animation::play(PlaybackDirection playbackDirection, RepeatMode repeatMode)
-{
-	fIsPlaying = true;
-
-	fPlaybackDirection = playbackDirection;
-	fRepeatMode = repeatMode;
-
-	fTimeLastRun = std::chrono::steady_clock::now();
-
-	onPlay();
-}
-
-void Animation::onPlay()
+Animation::Animation(AnimationEngine &engine, float duration, EasingFunction easingFunction) : fEngine(engine.shared_from_this()),
+																							  fTrack(engine.createTrack(duration, easingFunction))
 {
 }
 
-void Animation::onSeek()
+Animation::Animation(const Animation &other) : fEngine(other.fEngine),
+											   fTrack(other.fEngine ? other.fEngine->cloneTrack(other.fTrack) : -1)
 {
 }
 
-void Animation::onDurationChange()
+Animation::Animation(Animation &&other) : fEngine(std::move(other.fEngine)),
+										  fTrack(other.fTrack)
 {
+	other.fTrack = -1;
 }
 
-void Animation::onSpeedChange()
+Animation::~Animation()
 {
+	if (fEngine)
+		fEngine->destroyTrack(fTrack);
 }
 
-void Animation::pause()
+Animation &Animation::operator=(const Animation &other)
 {
-	fIsPlaying = false;
-}
+	if (this != &other)
+	{
+		if (fEngine)
+			fEngine->destroyTrack(fTrack);
 
-void Animation::seek(float time)
-{
-	fCurrentTime = wolf::clamp(time, 0.0f, fDuration);
-	fTimeLastRun = std::chrono::steady_clock::now();
+		fEngine = other.fEngine;
+		fTrack = fEngine ? fEngine->cloneTrack(other.fTrack) : -1;
+	}
 
-	onSeek();
+	return *this;
 }
 
-void Animation::rewind()
+Animation &Animation::operator=(Animation &&other)
 {
-	seek(0);
-}
+	if (this != &other)
+	{
+		if (fEngine)
+			fEngine->destroyTrack(fTrack);
 
-float Animation::getCurrentTime()
-{
-	return fCurrentTime;
-}
+		fEngine = std::move(other.fEngine);
+		fTrack = other.fTrack;
+		other.fTrack = -1;
+	}
 
-float Animation::getDuration()
-{
-	return fDuration;
+	return *this;
 }
 
-void Animation::setDuration(float duration)
+void Animation::play(PlaybackDirection playbackDirection, RepeatMode repeatMode)
 {
-	fDuration = duration;
+	DISTRHO_SAFE_ASSERT_RETURN(fEngine, );
 
-	onDurationChange();
-}
+	//only NoRepeat is supported for now
+	(void)repeatMode;
 
-bool Animation::isPlaying()
-{
-	return fIsPlaying;
+	fEngine->play(fTrack, playbackDirection == Forward ? 1 : -1);
 }
 
-void Animation::applyEasing()
-{
-	//TODO
-}
-
-void Animation::setSpeed(float speed)
+void Animation::pause()
 {
-	fSpeed = speed;
+	DISTRHO_SAFE_ASSERT_RETURN(fEngine, );
 
-	onSpeedChange();
+	fEngine->pause(fTrack);
 }
 
-void Animation::synchronize()
+void Animation::seek(float time)
 {
-	using namespace std::chrono;
-	steady_clock::time_point now = steady_clock::now();
-
-	float deltaTime = duration_cast<duration<float>>((now - fTimeLastRun) * fSpeed).count();
-
-	if (fPlaybackDirection == Forward)
-		fCurrentTime = std::min(fDuration, fCurrentTime + deltaTime);
-	else
-		fCurrentTime = std::max(0.0f, fCurrentTime - deltaTime);
+	DISTRHO_SAFE_ASSERT_RETURN(fEngine, );
 
-	fTimeLastRun = now;
+	fEngine->seek(fTrack, time);
 }
 
-void Animation::pauseIfDone()
+void Animation::rewind()
 {
-	if ((fPlaybackDirection == Forward && fCurrentTime >= fDuration) || (fPlaybackDirection == Backward && fCurrentTime <= 0.0f))
-	{
-		this->pause();
-	}
+	seek(0);
 }
 
-FloatTransition::FloatTransition() : Animation(0.0f, noEasing)
+float Animation::getCurrentTime()
 {
-}
+	DISTRHO_SAFE_ASSERT_RETURN(fEngine, 0.0f);
 
-FloatTransition::FloatTransition(float duration, float *initialValue, float targetValue, EasingFunction easingFunction) : Animation(duration, easingFunction),
-																														  fInitialValue(*initialValue),
-																														  fCurrentValue(initialValue),
-																														  fTargetValue(targetValue)
-{
+	return fEngine->getTime(fTrack);
 }
 
-FloatTransition::~FloatTransition()
+float Animation::getDuration()
 {
-}
+	DISTRHO_SAFE_ASSERT_RETURN(fEngine, 0.0f);
 
-void FloatTransition::applyEasing()
-{
+	return fEngine->getDuration(fTrack);
 }
 
-void FloatTransition::run()
+void Animation::setDuration(float duration)
 {
-	synchronize();
-
-	//Just some cheap lerp for now
-	*fCurrentValue = wolf::lerp(fInitialValue, fTargetValue, fCurrentTime / fDuration);
+	DISTRHO_SAFE_ASSERT_RETURN(fEngine, );
 
-	pauseIfDone();
+	fEngine->setDuration(fTrack, duration);
 }
 
-AnimationContainer::AnimationContainer(float duration, EasingFunction easingFunction) : Animation(duration, easingFunction)
+bool Animation::isPlaying()
 {
+	return fEngine && fEngine->isPlaying(fTrack);
 }
 
-AnimationContainer::~AnimationContainer()
+void Animation::setSpeed(float speed)
 {
-}
+	DISTRHO_SAFE_ASSERT_RETURN(fEngine, );
 
-void AnimationContainer::applyEasing()
-{
+	fEngine->setSpeed(fTrack, speed);
 }
 
-void AnimationContainer::onPlay()
+void Animation::setEasing(int easing)
 {
-	for (size_t i = 0; i < fAnimations.size(); ++i)
-	{
-		fAnimations[i]->play(fPlaybackDirection, fRepeatMode);
-	}
-}
+	DISTRHO_SAFE_ASSERT_RETURN(fEngine, );
 
-void AnimationContainer::onSeek()
-{
-	for (size_t i = 0; i < fAnimations.size(); ++i)
-	{
-		fAnimations[i]->seek(fCurrentTime);
-	}
+	fEngine->setEasing(fTrack, easing);
 }
 
-void AnimationContainer::onDurationChange()
+void Animation::addTween(float *value, float targetValue)
 {
-	for (size_t i = 0; i < fAnimations.size(); ++i)
-	{
-		fAnimations[i]->setDuration(fDuration);
-	}
-}
+	DISTRHO_SAFE_ASSERT_RETURN(fEngine, );
 
-void AnimationContainer::onSpeedChange()
-{
-	for (size_t i = 0; i < fAnimations.size(); ++i)
-	{
-		fAnimations[i]->setSpeed(fSpeed);
-	}
+	fEngine->addTween(fTrack, value, targetValue);
 }
 
-void AnimationContainer::run()
+FloatTransition::FloatTransition() : Animation()
 {
-	synchronize();
-
-	for (size_t i = 0; i < fAnimations.size(); ++i)
-	{
-		fAnimations[i]->run();
-	}
-
-	pauseIfDone();
 }
 
-ColorTransition::ColorTransition(float duration, Color *initialColor, Color targetColor, EasingFunction easingFunction) : AnimationContainer(duration, easingFunction)
+FloatTransition::FloatTransition(AnimationEngine &engine, float duration, float *initialValue, float targetValue, EasingFunction easingFunction) : Animation(engine, duration, easingFunction)
 {
-	fAnimations = std::vector<std::shared_ptr<Animation>>(4);
-
-	fAnimations[0] = std::make_shared<FloatTransition>(duration, &initialColor->red, targetColor.red, easingFunction);
-	fAnimations[1] = std::make_shared<FloatTransition>(duration, &initialColor->green, targetColor.green, easingFunction);
-	fAnimations[2] = std::make_shared<FloatTransition>(duration, &initialColor->blue, targetColor.blue, easingFunction);
-	fAnimations[3] = std::make_shared<FloatTransition>(duration, &initialColor->alpha, targetColor.alpha, easingFunction);
+	addTween(initialValue, targetValue);
 }
 
-ColorTransition::~ColorTransition()
+ColorTransition::ColorTransition(AnimationEngine &engine, float duration, Color *initialColor, Color targetColor, EasingFunction easingFunction) : Animation(engine, duration, easingFunction)
 {
+	addTween(&initialColor->red, targetColor.red);
+	addTween(&initialColor->green, targetColor.green);
+	addTween(&initialColor->blue, targetColor.blue);
+	addTween(&initialColor->alpha, targetColor.alpha);
 }
 
-GradientTransition::GradientTransition() : AnimationContainer(0)
+GradientTransition::GradientTransition() : Animation()
 {
 }
 
-GradientTransition::GradientTransition(float duration, NanoVG::Paint *initialGradient, NanoVG::Paint targetGradient, EasingFunction easingFunction) : AnimationContainer(duration, easingFunction)
+GradientTransition::GradientTransition(AnimationEngine &engine, float duration, NanoVG::Paint *initialGradient, NanoVG::Paint targetGradient, EasingFunction easingFunction) : Animation(engine, duration, easingFunction)
 {
-	fAnimations = std::vector<std::shared_ptr<Animation>>(2);
-
-	fAnimations[0] = std::make_shared<ColorTransition>(duration, &initialGradient->innerColor, targetGradient.innerColor, easingFunction);
-	fAnimations[1] = std::make_shared<ColorTransition>(duration, &initialGradient->outerColor, targetGradient.outerColor, easingFunction);
-}
+	addTween(&initialGradient->innerColor.red, targetGradient.innerColor.red);
+	addTween(&initialGradient->innerColor.green, targetGradient.innerColor.green);
+	addTween(&initialGradient->innerColor.blue, targetGradient.innerColor.blue);
+	addTween(&initialGradient->innerColor.alpha, targetGradient.innerColor.alpha);
 
-GradientTransition::~GradientTransition()
-{
+	addTween(&initialGradient->outerColor.red, targetGradient.outerColor.red);
+	addTween(&initialGradient->outerColor.green, targetGradient.outerColor.green);
+	addTween(&initialGradient->outerColor.blue, targetGradient.outerColor.blue);
+	addTween(&initialGradient->outerColor.alpha, targetGradient.outerColor.alpha);
 }
 
-END_NAMESPACE_DISTRHO
\ No newline at end of file
+END_NAMESPACE_DISTRHO
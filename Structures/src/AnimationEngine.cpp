@@ -0,0 +1,334 @@
+#include "AnimationEngine.hpp"
+#include "Mathf.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+START_NAMESPACE_DISTRHO
+
+static float linearCurve(float t, const float *)
+{
+    return t;
+}
+
+static float easeInPowerCurve(float t, const float *params)
+{
+    return std::pow(t, params[0]);
+}
+
+static float easeOutPowerCurve(float t, const float *params)
+{
+    return 1.0f - std::pow(1.0f - t, params[0]);
+}
+
+static float easeInOutPowerCurve(float t, const float *params)
+{
+    if (t < 0.5f)
+        return 0.5f * std::pow(2.0f * t, params[0]);
+
+    return 1.0f - 0.5f * std::pow(2.0f - 2.0f * t, params[0]);
+}
+
+static float cubicBezier(float s, float p1, float p2)
+{
+    const float u = 1.0f - s;
+
+    return 3.0f * u * u * s * p1 + 3.0f * u * s * s * p2 + s * s * s;
+}
+
+static float cubicBezierCurve(float t, const float *params)
+{
+    //find the parameter of the curve at which its x is t, by bisection since x is monotonic on [0, 1]
+    float low = 0.0f;
+    float high = 1.0f;
+
+    for (int i = 0; i < 24; ++i)
+    {
+        const float s = (low + high) * 0.5f;
+
+        if (cubicBezier(s, params[0], params[2]) < t)
+            low = s;
+        else
+            high = s;
+    }
+
+    return cubicBezier((low + high) * 0.5f, params[1], params[3]);
+}
+
+static float springCurve(float t, const float *params)
+{
+    const float damping = params[0];
+    const float frequency = 2.0f * wolf::pi<float>() * params[1];
+
+    return 1.0f - std::exp(-damping * t) * std::cos(frequency * t);
+}
+
+AnimationEngine::AnimationEngine()
+{
+    //in the order of Animation::EasingFunction
+    const float power2 = 2.0f;
+    const float power4 = 4.0f;
+    const float power3 = 3.0f;
+    const float spring[] = {6.0f, 1.5f};
+
+    addEasingTable(linearCurve, nullptr);
+    addEasingTable(easeOutPowerCurve, &power2);
+    addEasingTable(easeOutPowerCurve, &power4);
+    addEasingTable(easeInPowerCurve, &power2);
+    addEasingTable(easeInPowerCurve, &power4);
+    addEasingTable(easeInOutPowerCurve, &power3);
+    addEasingTable(springCurve, spring);
+}
+
+int AnimationEngine::addEasingTable(float (*curve)(float t, const float *params), const float *params)
+{
+    const int easing = fEasingTables.size() / (easingResolution + 1);
+
+    for (int i = 0; i <= easingResolution; ++i)
+    {
+        fEasingTables.push_back(curve((float)i / easingResolution, params));
+    }
+
+    //the ends are exact, so that a finished animation lands on its target
+    fEasingTables[easing * (easingResolution + 1)] = 0.0f;
+    fEasingTables.back() = 1.0f;
+
+    return easing;
+}
+
+int AnimationEngine::addCubicBezierEasing(float x1, float y1, float x2, float y2)
+{
+    const float params[] = {wolf::clamp(x1, 0.0f, 1.0f), y1, wolf::clamp(x2, 0.0f, 1.0f), y2};
+
+    return addEasingTable(cubicBezierCurve, params);
+}
+
+int AnimationEngine::addSpringEasing(float damping, float oscillations)
+{
+    const float params[] = {damping, oscillations};
+
+    return addEasingTable(springCurve, params);
+}
+
+bool AnimationEngine::isTrack(int track) const
+{
+    return track >= 0 && (size_t)track < fFlags.size() && fFlags[track] & InUse;
+}
+
+int AnimationEngine::createTrack(float duration, int easing)
+{
+    int track;
+
+    if (!fFreeTracks.empty())
+    {
+        track = fFreeTracks.back();
+        fFreeTracks.pop_back();
+    }
+    else
+    {
+        track = fTime.size();
+
+        fTime.push_back(0.0f);
+        fDuration.push_back(0.0f);
+        fSpeed.push_back(0.0f);
+        fProgress.push_back(0.0f);
+        fLastStep.push_back(std::chrono::steady_clock::time_point());
+        fDirection.push_back(1);
+        fEasing.push_back(0);
+        fFlags.push_back(0);
+    }
+
+    fTime[track] = 0.0f;
+    fDuration[track] = duration;
+    fSpeed[track] = 1.0f;
+    fProgress[track] = 0.0f;
+    fLastStep[track] = std::chrono::steady_clock::now();
+    fDirection[track] = 1;
+    fEasing[track] = easing;
+    fFlags[track] = InUse;
+
+    return track;
+}
+
+int AnimationEngine::cloneTrack(int track)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(isTrack(track), -1);
+
+    const int clone = createTrack(fDuration[track], fEasing[track]);
+
+    fTime[clone] = fTime[track];
+    fSpeed[clone] = fSpeed[track];
+    fLastStep[clone] = fLastStep[track];
+    fDirection[clone] = fDirection[track];
+    fFlags[clone] = fFlags[track];
+
+    //push_back may reallocate, so the tweens to copy are counted first
+    const size_t tweenCount = fTargets.size();
+
+    for (size_t i = 0; i < tweenCount; ++i)
+    {
+        if (fTweenTracks[i] != track)
+            continue;
+
+        fTargets.push_back(fTargets[i]);
+        fFrom.push_back(fFrom[i]);
+        fTo.push_back(fTo[i]);
+        fTweenTracks.push_back(clone);
+    }
+
+    return clone;
+}
+
+void AnimationEngine::destroyTrack(int track)
+{
+    if (!isTrack(track))
+        return;
+
+    for (size_t i = fTargets.size(); i-- > 0;)
+    {
+        if (fTweenTracks[i] != track)
+            continue;
+
+        //swap with the last tween, since their order doesn't matter
+        fTargets[i] = fTargets.back();
+        fFrom[i] = fFrom.back();
+        fTo[i] = fTo.back();
+        fTweenTracks[i] = fTweenTracks.back();
+
+        fTargets.pop_back();
+        fFrom.pop_back();
+        fTo.pop_back();
+        fTweenTracks.pop_back();
+    }
+
+    fFlags[track] = 0;
+    fFreeTracks.push_back(track);
+}
+
+void AnimationEngine::play(int track, int direction, std::chrono::steady_clock::time_point now)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(isTrack(track), );
+
+    fFlags[track] |= Playing;
+    fDirection[track] = direction > 0 ? 1 : -1;
+    fLastStep[track] = now;
+}
+
+void AnimationEngine::pause(int track)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(isTrack(track), );
+
+    fFlags[track] &= ~Playing;
+}
+
+void AnimationEngine::seek(int track, float time, std::chrono::steady_clock::time_point now)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(isTrack(track), );
+
+    fTime[track] = wolf::clamp(time, 0.0f, fDuration[track]);
+    fLastStep[track] = now;
+}
+
+bool AnimationEngine::isPlaying(int track) const
+{
+    return isTrack(track) && fFlags[track] & Playing;
+}
+
+float AnimationEngine::getTime(int track) const
+{
+    DISTRHO_SAFE_ASSERT_RETURN(isTrack(track), 0.0f);
+
+    return fTime[track];
+}
+
+float AnimationEngine::getDuration(int track) const
+{
+    DISTRHO_SAFE_ASSERT_RETURN(isTrack(track), 0.0f);
+
+    return fDuration[track];
+}
+
+void AnimationEngine::setDuration(int track, float duration)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(isTrack(track), );
+
+    fDuration[track] = duration;
+}
+
+void AnimationEngine::setSpeed(int track, float speed)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(isTrack(track), );
+
+    fSpeed[track] = speed;
+}
+
+void AnimationEngine::addTween(int track, float *target, float to)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(isTrack(track) && target != nullptr, );
+
+    fTargets.push_back(target);
+    fFrom.push_back(*target);
+    fTo.push_back(to);
+    fTweenTracks.push_back(track);
+}
+
+void AnimationEngine::setEasing(int track, int easing)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(isTrack(track), );
+    DISTRHO_SAFE_ASSERT_RETURN(easing >= 0 && (size_t)easing < fEasingTables.size() / (easingResolution + 1), );
+
+    fEasing[track] = easing;
+}
+
+void AnimationEngine::advance(std::chrono::steady_clock::time_point now)
+{
+    using namespace std::chrono;
+
+    const size_t trackCount = fTime.size();
+
+    for (size_t i = 0; i < trackCount; ++i)
+    {
+        if (!(fFlags[i] & Playing))
+            continue;
+
+        const float deltaTime = duration_cast<duration<float>>((now - fLastStep[i]) * fSpeed[i]).count();
+
+        fTime[i] = wolf::clamp(fTime[i] + deltaTime * fDirection[i], 0.0f, fDuration[i]);
+        fLastStep[i] = now;
+
+        const float progress = fDuration[i] > 0.0f ? fTime[i] / fDuration[i] : (fDirection[i] > 0 ? 1.0f : 0.0f);
+
+        //read the eased progress from the table of the curve, between its two nearest samples
+        const float position = progress * easingResolution;
+        const int sample = std::min((int)position, easingResolution - 1);
+        const float *table = &fEasingTables[fEasing[i] * (easingResolution + 1) + sample];
+
+        fProgress[i] = table[0] + (table[1] - table[0]) * (position - sample);
+        fFlags[i] |= Stepped;
+    }
+
+    const size_t tweenCount = fTargets.size();
+
+    for (size_t i = 0; i < tweenCount; ++i)
+    {
+        const int track = fTweenTracks[i];
+
+        //not wolf::lerp, which clamps away the overshoot of springs and beziers
+        if (fFlags[track] & Stepped)
+            *fTargets[i] = fFrom[i] + (fTo[i] - fFrom[i]) * fProgress[track];
+    }
+
+    //the tracks which reached their end have applied their last step, so they can stop
+    for (size_t i = 0; i < trackCount; ++i)
+    {
+        if (!(fFlags[i] & Stepped))
+            continue;
+
+        fFlags[i] &= ~Stepped;
+
+        if ((fDirection[i] > 0 && fTime[i] >= fDuration[i]) || (fDirection[i] < 0 && fTime[i] <= 0.0f))
+            fFlags[i] &= ~Playing;
+    }
+}
+
+END_NAMESPACE_DISTRHO
@@ -0,0 +1,59 @@
+#include "AntialiasedWaveshaper.hpp"
+#include "Mathf.hpp"
+
+#include <cmath>
+
+START_NAMESPACE_DISTRHO
+
+namespace wolf
+{
+
+//below this difference between two inputs, the division gets too imprecise and the graph is evaluated directly
+static const double minInputDelta = 1e-5;
+
+AntialiasedWaveshaper::AntialiasedWaveshaper(GraphBase &graph) : fGraph(graph)
+{
+    reset();
+}
+
+void AntialiasedWaveshaper::reset()
+{
+    fPreviousInput = 0.0;
+    fPreviousAntiderivative = fGraph.getAntiderivativeAt(0.0);
+    fGraphRevision = fGraph.getRevision();
+}
+
+float AntialiasedWaveshaper::process(float input)
+{
+    const double x = wolf::clamp(static_cast<double>(input), -1.0, 1.0);
+
+    //the graph changed since the previous sample, so its antiderivative did too
+    if (fGraph.getRevision() != fGraphRevision)
+    {
+        fPreviousAntiderivative = fGraph.getAntiderivativeAt(fPreviousInput);
+        fGraphRevision = fGraph.getRevision();
+    }
+
+    const double antiderivative = fGraph.getAntiderivativeAt(x);
+    const double delta = x - fPreviousInput;
+
+    double result;
+
+    if (std::abs(delta) < minInputDelta)
+    {
+        result = fGraph.getValueAt((x + fPreviousInput) / 2);
+    }
+    else
+    {
+        result = (antiderivative - fPreviousAntiderivative) / delta;
+    }
+
+    fPreviousInput = x;
+    fPreviousAntiderivative = antiderivative;
+
+    return static_cast<float>(result);
+}
+
+} // namespace wolf
+
+END_NAMESPACE_DISTRHO
@@ -0,0 +1,116 @@
+#include "Arena.hpp"
+
+#include <cstdlib>
+#include <cstdint>
+
+START_NAMESPACE_DISTRHO
+
+namespace wolf
+{
+
+Arena::Arena(const size_t capacity) : fMemory(static_cast<unsigned char *>(std::malloc(capacity))),
+                                      fCapacity(fMemory != nullptr ? capacity : 0),
+                                      fUsed(0)
+{
+}
+
+Arena::~Arena()
+{
+    std::free(fMemory);
+}
+
+void *Arena::allocate(const size_t size, const size_t alignment)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(alignment != 0 && (alignment & (alignment - 1)) == 0, nullptr);
+
+    const uintptr_t base = reinterpret_cast<uintptr_t>(fMemory);
+    const uintptr_t aligned = (base + fUsed + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    const size_t offset = aligned - base;
+
+    if (offset + size > fCapacity)
+        return nullptr;
+
+    fUsed = offset + size;
+
+    return fMemory + offset;
+}
+
+void Arena::reset()
+{
+    fUsed = 0;
+}
+
+size_t Arena::getCapacity() const
+{
+    return fCapacity;
+}
+
+size_t Arena::getUsed() const
+{
+    return fUsed;
+}
+
+SlabAllocator::SlabAllocator(Arena &arena, const size_t blockSize, const int blockCount, const size_t alignment) : fMemory(nullptr),
+                                                                                                               fBlockSize(0),
+                                                                                                               fAlignment(alignment),
+                                                                                                               fBlockCount(0),
+                                                                                                               fFreeList(nullptr),
+                                                                                                               fFreeCount(0)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(blockCount >= 0, );
+    DISTRHO_SAFE_ASSERT_RETURN(alignment >= alignof(void *) && (alignment & (alignment - 1)) == 0, );
+
+    //a free block must fit the link to the next one, and every block must stay aligned
+    const size_t size = blockSize > sizeof(void *) ? blockSize : sizeof(void *);
+    fBlockSize = (size + alignment - 1) & ~(alignment - 1);
+
+    fMemory = static_cast<unsigned char *>(arena.allocate(fBlockSize * blockCount, alignment));
+
+    DISTRHO_SAFE_ASSERT_RETURN(fMemory != nullptr || blockCount == 0, );
+
+    fBlockCount = blockCount;
+
+    //link the blocks in order, so that the first allocations are contiguous
+    for (int i = blockCount; i-- > 0;)
+    {
+        deallocate(fMemory + fBlockSize * i);
+    }
+}
+
+void *SlabAllocator::allocate()
+{
+    if (fFreeList == nullptr)
+        return nullptr;
+
+    void *block = fFreeList;
+    fFreeList = *static_cast<void **>(block);
+    --fFreeCount;
+
+    return block;
+}
+
+void SlabAllocator::deallocate(void *block)
+{
+    if (block == nullptr)
+        return;
+
+    DISTRHO_SAFE_ASSERT_RETURN(block >= fMemory && block < fMemory + fBlockSize * fBlockCount, );
+
+    *static_cast<void **>(block) = fFreeList;
+    fFreeList = block;
+    ++fFreeCount;
+}
+
+int SlabAllocator::getBlockCount() const
+{
+    return fBlockCount;
+}
+
+int SlabAllocator::getFreeCount() const
+{
+    return fFreeCount;
+}
+
+} // namespace wolf
+
+END_NAMESPACE_DISTRHO
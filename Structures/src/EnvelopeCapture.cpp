@@ -0,0 +1,107 @@
+#include "EnvelopeCapture.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+START_NAMESPACE_DISTRHO
+
+static uint32_t nextPowerOfTwo(const int value)
+{
+    uint32_t powerOfTwo = 1;
+
+    while ((int)powerOfTwo < value)
+    {
+        powerOfTwo <<= 1;
+    }
+
+    return powerOfTwo;
+}
+
+EnvelopeCapture::EnvelopeCapture(const int capacity) : fFrames(new Frame[nextPowerOfTwo(capacity)]),
+                                                       fMask(nextPowerOfTwo(capacity) - 1),
+                                                       fWriteIndex(0),
+                                                       fReadIndex(0),
+                                                       fSamplesPerFrame(256),
+                                                       fSamplesInFrame(0),
+                                                       fMin(0.0f),
+                                                       fMax(0.0f),
+                                                       fSumOfSquares(0.0f)
+{
+}
+
+EnvelopeCapture::~EnvelopeCapture()
+{
+    delete[] fFrames;
+}
+
+void EnvelopeCapture::setDecimation(const int samplesPerFrame)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(samplesPerFrame > 0, );
+
+    fSamplesPerFrame = samplesPerFrame;
+    fSamplesInFrame = 0;
+}
+
+void EnvelopeCapture::process(const float *samples, const uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const float sample = samples[i];
+
+        if (fSamplesInFrame == 0)
+        {
+            fMin = sample;
+            fMax = sample;
+            fSumOfSquares = 0.0f;
+        }
+
+        fMin = std::min(fMin, sample);
+        fMax = std::max(fMax, sample);
+        fSumOfSquares += sample * sample;
+
+        if (++fSamplesInFrame == fSamplesPerFrame)
+        {
+            pushFrame();
+            fSamplesInFrame = 0;
+        }
+    }
+}
+
+void EnvelopeCapture::pushFrame()
+{
+    const uint32_t writeIndex = fWriteIndex.load(std::memory_order_relaxed);
+    const uint32_t readIndex = fReadIndex.load(std::memory_order_acquire);
+
+    //full: the UI isn't reading, so this frame is dropped
+    if (writeIndex - readIndex > fMask)
+        return;
+
+    Frame &frame = fFrames[writeIndex & fMask];
+    frame.min = fMin;
+    frame.max = fMax;
+    frame.rms = std::sqrt(fSumOfSquares / fSamplesPerFrame);
+
+    fWriteIndex.store(writeIndex + 1, std::memory_order_release);
+}
+
+int EnvelopeCapture::read(Frame *frames, const int count)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(count >= 0, 0);
+
+    const uint32_t readIndex = fReadIndex.load(std::memory_order_relaxed);
+    const uint32_t writeIndex = fWriteIndex.load(std::memory_order_acquire);
+
+    const uint32_t available = writeIndex - readIndex;
+    const int taken = available < (uint32_t)count ? available : count;
+
+    for (int i = 0; i < taken; ++i)
+    {
+        frames[i] = fFrames[(readIndex + i) & fMask];
+    }
+
+    fReadIndex.store(readIndex + taken, std::memory_order_release);
+
+    return taken;
+}
+
+END_NAMESPACE_DISTRHO
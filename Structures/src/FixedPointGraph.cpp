@@ -0,0 +1,75 @@
+#include "FixedPointGraph.hpp"
+#include "Mathf.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+START_NAMESPACE_DISTRHO
+
+namespace wolf
+{
+
+static float fromQ15Unclamped(const int32_t value)
+{
+    return value / 32767.0f;
+}
+
+//the number of low bits of a Q15 value used to interpolate between two entries of the table
+static const int interpolationBits = 5;
+
+static_assert((1 << (15 - interpolationBits)) == fixedPointTableSize, "the table must cover the whole Q15 range");
+
+//the x value of an entry of the table
+static float getTableX(const int index)
+{
+    return std::min(1.0f, fromQ15Unclamped(index << interpolationBits));
+}
+
+FixedPointGraph::FixedPointGraph()
+{
+    //identity, like a default graph
+    for (int i = 0; i <= fixedPointTableSize; ++i)
+    {
+        fTable[i] = toQ15(getTableX(i));
+    }
+}
+
+void FixedPointGraph::bake(GraphBase &graph)
+{
+    int segment = 0;
+
+    for (int i = 0; i <= fixedPointTableSize; ++i)
+    {
+        fTable[i] = toQ15(graph.getValueAt(getTableX(i), segment));
+    }
+}
+
+int16_t FixedPointGraph::getValueAt(int16_t x) const
+{
+    //the graph is odd, so only the positive half is stored
+    const int32_t absX = std::min<int32_t>(std::abs((int32_t)x), 32767);
+
+    const int32_t index = absX >> interpolationBits;
+    const int32_t fraction = absX & ((1 << interpolationBits) - 1);
+
+    const int32_t left = fTable[index];
+    const int32_t right = fTable[index + 1];
+
+    const int32_t result = left + (((right - left) * fraction) >> interpolationBits);
+
+    return x >= 0 ? result : -result;
+}
+
+int16_t FixedPointGraph::toQ15(float value)
+{
+    return std::lrint(wolf::clamp(value, -1.0f, 1.0f) * 32767.0f);
+}
+
+float FixedPointGraph::fromQ15(int16_t value)
+{
+    return fromQ15Unclamped(value);
+}
+
+} // namespace wolf
+
+END_NAMESPACE_DISTRHO
@@ -6,12 +6,16 @@
 #include <cstdio>
 #include <cassert>
 #include <cstring>
+#include <new>
 
 START_NAMESPACE_DISTRHO
 
 namespace wolf
 {
 
+struct AsinWaveIntegralTable;
+static const AsinWaveIntegralTable &getAsinWaveIntegralTable();
+
 Vertex::Vertex() : x(0),
                    y(0),
                    xDirty(true),
@@ -24,11 +28,12 @@ Vertex::Vertex() : x(0),
                    graphHType(None),
                    graphVType(None),
                    type(SingleCurve),
+                   integral(0.0),
                    graphPtr(nullptr)
 {
 }
 
-Vertex::Vertex(float posX, float posY, float tension, CurveType type, Graph *graphPtr) : x(posX),
+Vertex::Vertex(float posX, float posY, float tension, CurveType type, GraphBase *graphPtr) : x(posX),
                                                                                          y(posY),
                                                                                          xDirty(true),
                                                                                          yDirty(true),
@@ -40,32 +45,34 @@ Vertex::Vertex(float posX, float posY, float tension, CurveType type, Graph *gra
                                                                                          graphHType(None),
                                                                                          graphVType(None),
                                                                                          type(type),
+                                                                                         integral(0.0),
                                                                                          graphPtr(graphPtr)
 {
 }
 
-static float powerScale(float input, float tension, float maxExponent, float p1x, float p1y, float p2x, float p2y, bool inverse)
+template <typename T>
+static T powerScale(T input, T tension, T maxExponent, T p1x, T p1y, T p2x, T p2y, bool inverse)
 {
     DISTRHO_SAFE_ASSERT_RETURN(maxExponent >= 1, input);
 
-    const float inputSign = input >= 0 ? 1 : -1;
-    const bool tensionIsPositive = tension >= 0.0f;
+    const T inputSign = input >= 0 ? 1 : -1;
+    const bool tensionIsPositive = tension >= 0;
 
     tension = std::abs(tension);
 
-    const float deltaX = p2x - p1x;
-    const float deltaY = p2y - p1y;
+    const T deltaX = p2x - p1x;
+    const T deltaY = p2y - p1y;
 
     input = std::abs(input);
 
-    float exponent = 1 + tension * (maxExponent - 1);
+    T exponent = 1 + tension * (maxExponent - 1);
 
     if (inverse)
     {
-        exponent = 1.0f / exponent;
+        exponent = 1 / exponent;
     }
 
-    float result;
+    T result;
 
     if (tensionIsPositive)
     {
@@ -103,11 +110,11 @@ static float bendPlus(float x, float warpAmount, bool inverse)
 {
     if (x < 0.5f)
     {
-        return powerScale(x, -warpAmount, 3, 0.0f, 0.0f, 0.5f, 0.5f, inverse);
+        return powerScale(x, -warpAmount, 3.0f, 0.0f, 0.0f, 0.5f, 0.5f, inverse);
     }
     else if (x > 0.5f)
     {
-        return powerScale(x, warpAmount, 3, 0.5f, 0.5f, 1.0f, 1.0f, inverse);
+        return powerScale(x, warpAmount, 3.0f, 0.5f, 0.5f, 1.0f, 1.0f, inverse);
     }
     else
     {
@@ -119,11 +126,11 @@ static float bendMinus(float x, float warpAmount, bool inverse)
 {
     if (x < 0.5f)
     {
-        return powerScale(x, warpAmount, 3, 0.0f, 0.0f, 0.5f, 0.5f, inverse);
+        return powerScale(x, warpAmount, 3.0f, 0.0f, 0.0f, 0.5f, 0.5f, inverse);
     }
     else if (x > 0.5f)
     {
-        return powerScale(x, -warpAmount, 3, 0.5f, 0.5f, 1.0f, 1.0f, inverse);
+        return powerScale(x, -warpAmount, 3.0f, 0.5f, 0.5f, 1.0f, 1.0f, inverse);
     }
     else
     {
@@ -268,12 +275,16 @@ void Vertex::setX(float x)
 {
     this->x = unwarpCoordinate(x, graphPtr->getHorizontalWarpAmount(), graphPtr->getHorizontalWarpType());
     xDirty = true;
+
+    graphPtr->invalidateSegmentGrid();
 }
 
 void Vertex::setY(float y)
 {
     this->y = unwarpCoordinate(y, graphPtr->getVerticalWarpAmount(), graphPtr->getVerticalWarpType());
     yDirty = true;
+
+    graphPtr->invalidateIntegrals();
 }
 
 void Vertex::setPosition(float x, float y)
@@ -285,91 +296,179 @@ void Vertex::setPosition(float x, float y)
 void Vertex::setTension(float tension)
 {
     this->tension = tension;
+
+    graphPtr->invalidateIntegrals();
 }
 
 void Vertex::setType(CurveType type)
 {
     this->type = type;
+
+    graphPtr->invalidateIntegrals();
 }
 
-void Vertex::setGraphPtr(Graph *graphPtr)
+void Vertex::setGraphPtr(GraphBase *graphPtr)
 {
     this->graphPtr = graphPtr;
 }
 
-Graph::Graph() : vertexCount(0),
-                 horizontalWarpAmount(0.0f),
-                 verticalWarpAmount(0.0f),
-                 horizontalWarpType(None),
-                 verticalWarpType(None),
-                 bipolarMode(false)
+GraphBase::GraphBase(void *vertexStorage, char *serializationBuffer, int capacity) : vertices(static_cast<Vertex *>(vertexStorage)),
+                                                                                      vertexCount(0),
+                                                                                      capacity(vertexStorage != nullptr && serializationBuffer != nullptr ? capacity : 0),
+                                                                                      horizontalWarpAmount(0.0f),
+                                                                                      verticalWarpAmount(0.0f),
+                                                                                      horizontalWarpType(None),
+                                                                                      verticalWarpType(None),
+                                                                                      bipolarMode(false),
+                                                                                      serializationBuffer(serializationBuffer),
+                                                                                      segmentGridDirty(true),
+                                                                                      integralsDirty(true),
+                                                                                      revision(0)
 {
+    //built here rather than on the first integral of a wave curve, which the audio thread asks for
+    getAsinWaveIntegralTable();
+
+    for (int i = 0; i < this->capacity; ++i)
+    {
+        new (&vertices[i]) Vertex();
+    }
+
+    if (this->capacity > 0)
+        serializationBuffer[0] = '\0';
+
     insertVertex(0.0f, 0.0f);
     insertVertex(1.0f, 1.0f);
 }
 
-float Graph::getOutValue(float input, float tension, float p1x, float p1y, float p2x, float p2y, CurveType type)
+GraphBase::~GraphBase()
 {
-    const float inputSign = input >= 0 ? 1 : -1;
+}
 
-    if (p1x == p2x)
+void GraphBase::copyFrom(const GraphBase &graph)
+{
+    horizontalWarpAmount = graph.horizontalWarpAmount;
+    verticalWarpAmount = graph.verticalWarpAmount;
+    horizontalWarpType = graph.horizontalWarpType;
+    verticalWarpType = graph.verticalWarpType;
+    bipolarMode = graph.bipolarMode;
+
+    DISTRHO_SAFE_ASSERT(graph.vertexCount <= capacity);
+
+    vertexCount = std::min(graph.vertexCount, capacity);
+
+    for (int i = 0; i < vertexCount; ++i)
     {
-        return inputSign * p2y;
+        vertices[i] = graph.vertices[i];
+        vertices[i].graphPtr = this;
+        vertices[i].xDirty = true;
+        vertices[i].yDirty = true;
     }
 
-    //should probably be stored as a normalized value instead
-    tension /= 100.0f;
+    invalidateSegmentGrid();
+}
 
-    const bool tensionIsPositive = tension >= 0.0f;
+//the vertices and their serialization buffer in a single allocation, so that a full arena can't keep half of a graph
+static void *allocateGraphStorage(Arena &arena, int capacity)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(capacity >= 0, nullptr);
+
+    return arena.allocate(sizeof(Vertex) * capacity + serializedVertexMaxLength * capacity + 1, alignof(Vertex));
+}
+
+DynamicGraph::DynamicGraph(Arena &arena, int capacity) : DynamicGraph(allocateGraphStorage(arena, capacity), capacity)
+{
+}
+
+DynamicGraph::DynamicGraph(void *storage, int capacity) : GraphBase(storage,
+                                                                    storage != nullptr ? static_cast<char *>(storage) + sizeof(Vertex) * capacity : nullptr,
+                                                                    capacity)
+{
+}
+
+template <typename T>
+static T shapeTension(T tension)
+{
+    //should probably be stored as a normalized value instead
+    tension /= 100;
 
     //make the curve bend more slowly when the tension is near 0
-    if (tensionIsPositive)
+    if (tension >= 0)
     {
-        tension = std::pow(tension, 1.2f);
+        return std::pow(tension, T(1.2));
     }
     else
     {
-        tension = -std::pow(-tension, 1.2f);
+        return -std::pow(-tension, T(1.2));
+    }
+}
+
+template <typename T>
+static int getStairsStepCount(T tension)
+{
+    return std::floor(2 / (tension * tension));
+}
+
+template <typename T>
+static T getWaveFrequency(T tension)
+{
+    //the wave is symmetric, so a negative frequency gives the same curve as a positive one
+    return std::abs(T(0.5) + std::floor(tension * 100));
+}
+
+template <typename T>
+T GraphBase::getOutValue(T input, T tension, T p1x, T p1y, T p2x, T p2y, CurveType type)
+{
+    const T inputSign = input >= 0 ? 1 : -1;
+
+    if (p1x == p2x)
+    {
+        return inputSign * p2y;
     }
 
-    const float deltaX = p2x - p1x;
-    const float deltaY = p2y - p1y;
+    tension = shapeTension(tension);
+
+    const bool tensionIsPositive = tension >= 0;
+
+    const T deltaX = p2x - p1x;
+    const T deltaY = p2y - p1y;
+
+    const T maxExponent = 15;
 
     switch (type)
     {
     case SingleCurve:
     {
-        return powerScale(input, tension, 15.0f, p1x, p1y, p2x, p2y, false);
+        return powerScale(input, tension, maxExponent, p1x, p1y, p2x, p2y, false);
     }
     case DoubleCurve:
     {
-        const float middleX = p1x + deltaX / 2.0f;
-        const float middleY = p1y + deltaY / 2.0f;
+        const T middleX = p1x + deltaX / 2;
+        const T middleY = p1y + deltaY / 2;
 
         if (std::abs(input) > middleX)
         {
-            return powerScale(input, -tension, 15.0f, middleX, middleY, p2x, p2y, false);
+            return powerScale(input, -tension, maxExponent, middleX, middleY, p2x, p2y, false);
         }
         else
         {
-            return powerScale(input, tension, 15.0f, p1x, p1y, middleX, middleY, false);
+            return powerScale(input, tension, maxExponent, p1x, p1y, middleX, middleY, false);
         }
     }
     case StairsCurve:
     {
-        if (tension == 0.0f) //straight line
+        if (tension == 0) //straight line
         {
-            return powerScale(input, tension, 15.0f, p1x, p1y, p2x, p2y, false);
+            return powerScale(input, tension, maxExponent, p1x, p1y, p2x, p2y, false);
         }
 
         input = std::abs(input);
 
-        int numSteps = std::floor(2.0f / std::pow(tension, 2.0f));
+        const int numSteps = getStairsStepCount(tension);
 
-        const float stepX = deltaX / (tensionIsPositive ? numSteps : numSteps - 1);
-        const float stepY = deltaY / (tensionIsPositive ? numSteps - 1 : numSteps);
+        const T stepX = deltaX / (tensionIsPositive ? numSteps : numSteps - 1);
+        const T stepY = deltaY / (tensionIsPositive ? numSteps - 1 : numSteps);
 
-        float result;
+        T result;
 
         if (tensionIsPositive)
         {
@@ -381,24 +480,23 @@ float Graph::getOutValue(float input, float tension, float p1x, float p1y, float
         }
 
         //clamped to avoid some overshoot, might not be necessary
-        const float minY = std::min(p1y, p2y);
-        const float maxY = std::max(p1y, p2y);
+        const T minY = std::min(p1y, p2y);
+        const T maxY = std::max(p1y, p2y);
 
         return inputSign * wolf::clamp(result, minY, maxY);
     }
     case WaveCurve:
     {
-        tension = std::floor(tension * 100.f);
         input = std::abs(input);
 
-        const float frequency = (0.5f + tension) / deltaX;
-        const float phase = p1x * frequency * 2.0f * M_PI;
+        const T frequency = getWaveFrequency(tension) / deltaX;
+        const T phase = p1x * frequency * 2 * wolf::pi<T>();
 
-        float wave = -std::cos(frequency * M_PI * 2.0f * input - phase) / 2.0f + 0.5f;
+        T wave = -std::cos(frequency * wolf::pi<T>() * 2 * input - phase) / 2 + T(0.5);
 
         if (!tensionIsPositive)
         {
-            wave = M_2_PI * std::asin(wave);
+            wave = wolf::twoOverPi<T>() * std::asin(wave);
         }
 
         return inputSign * (wave * deltaY + p1y);
@@ -408,81 +506,578 @@ float Graph::getOutValue(float input, float tension, float p1x, float p1y, float
     }
 }
 
-float Graph::getValueAt(float x)
+template <typename T>
+static T powerScaleIntegral(T input, T tension, T maxExponent, T p1x, T p1y, T p2x, T p2y)
 {
-    const float absX = std::abs(x);
+    const bool tensionIsPositive = tension >= 0;
+
+    tension = std::abs(tension);
 
-    DISTRHO_SAFE_ASSERT_RETURN(absX <= 1.0f, x);
+    const T deltaX = p2x - p1x;
+    const T deltaY = p2y - p1y;
 
-    //binary search
-    int left = 0;
-    int right = vertexCount - 1;
-    int mid = 0;
+    const T position = (input - p1x) / deltaX;
+    const T exponent = 1 + tension * (maxExponent - 1);
 
-    while (left <= right)
+    if (tensionIsPositive)
     {
-        mid = left + (right - left) / 2;
+        return deltaX * (deltaY * std::pow(position, exponent + 1) / (exponent + 1) + p1y * position);
+    }
+    else
+    {
+        return deltaX * (p2y * position - deltaY * (1 - std::pow(1 - position, exponent + 1)) / (exponent + 1));
+    }
+}
 
-        if (vertices[mid].getX() < absX)
-            left = mid + 1;
-        else if (vertices[mid].getX() > absX)
-            right = mid - 1;
+template <typename T>
+static T powerScaleDerivative(T input, T tension, T maxExponent, T p1x, T p1y, T p2x, T p2y)
+{
+    const bool tensionIsPositive = tension >= 0;
+
+    tension = std::abs(tension);
+
+    const T deltaX = p2x - p1x;
+    const T deltaY = p2y - p1y;
+
+    const T position = (input - p1x) / deltaX;
+    const T exponent = 1 + tension * (maxExponent - 1);
+
+    if (tensionIsPositive)
+    {
+        return deltaY * exponent * std::pow(position, exponent - 1) / deltaX;
+    }
+    else
+    {
+        return deltaY * exponent * std::pow(1 - position, exponent - 1) / deltaX;
+    }
+}
+
+/**
+ * The asin wave has no elementary antiderivative, so its integral over one period is tabulated,
+ * along with the wave itself, and evaluated with cubic hermite interpolation.
+ */
+struct AsinWaveIntegralTable
+{
+    static const int size = 1024;
+
+    AsinWaveIntegralTable();
+
+    static double getWaveAt(double phase);
+
+    template <typename T>
+    T getIntegralAt(T phase) const;
+
+    double integrals[size + 1];
+    double waves[size + 1];
+};
+
+double AsinWaveIntegralTable::getWaveAt(double phase)
+{
+    return wolf::twoOverPi<double>() * std::asin(0.5 - std::cos(phase) / 2);
+}
+
+AsinWaveIntegralTable::AsinWaveIntegralTable()
+{
+    const double step = 2 * wolf::pi<double>() / size;
+
+    //the wave has a corner at pi, which falls on an entry of the table, so simpson's rule converges quickly in every cell
+    const int subdivisions = 8;
+    const double subStep = step / subdivisions;
+
+    integrals[0] = 0.0;
+    waves[0] = getWaveAt(0.0);
+
+    for (int i = 1; i <= size; ++i)
+    {
+        const double start = (i - 1) * step;
+
+        double sum = getWaveAt(start) + getWaveAt(start + step);
+
+        for (int j = 1; j < subdivisions; ++j)
+        {
+            sum += (j % 2 == 0 ? 2 : 4) * getWaveAt(start + j * subStep);
+        }
+
+        integrals[i] = integrals[i - 1] + sum * subStep / 3;
+        waves[i] = getWaveAt(i * step);
+    }
+}
+
+template <typename T>
+T AsinWaveIntegralTable::getIntegralAt(T phase) const
+{
+    const T period = 2 * wolf::pi<T>();
+    const T step = period / size;
+
+    const T periods = std::floor(phase / period);
+    const T position = (phase - periods * period) / step;
+
+    const int index = std::min(static_cast<int>(position), size - 1);
+    const T t = position - index;
+
+    const T t2 = t * t;
+    const T t3 = t2 * t;
+
+    const T integral = (2 * t3 - 3 * t2 + 1) * static_cast<T>(integrals[index])
+                     + (t3 - 2 * t2 + t) * step * static_cast<T>(waves[index])
+                     + (3 * t2 - 2 * t3) * static_cast<T>(integrals[index + 1])
+                     + (t3 - t2) * step * static_cast<T>(waves[index + 1]);
+
+    return periods * static_cast<T>(integrals[size]) + integral;
+}
+
+static const AsinWaveIntegralTable &getAsinWaveIntegralTable()
+{
+    static const AsinWaveIntegralTable table;
+
+    return table;
+}
+
+template <typename T>
+T GraphBase::getOutIntegral(T input, T tension, T p1x, T p1y, T p2x, T p2y, CurveType type)
+{
+    if (p1x == p2x)
+    {
+        return 0;
+    }
+
+    input = std::abs(input);
+    tension = shapeTension(tension);
+
+    const bool tensionIsPositive = tension >= 0;
+
+    const T deltaX = p2x - p1x;
+    const T deltaY = p2y - p1y;
+
+    const T maxExponent = 15;
+
+    switch (type)
+    {
+    case SingleCurve:
+    {
+        return powerScaleIntegral(input, tension, maxExponent, p1x, p1y, p2x, p2y);
+    }
+    case DoubleCurve:
+    {
+        const T middleX = p1x + deltaX / 2;
+        const T middleY = p1y + deltaY / 2;
+
+        if (input > middleX)
+        {
+            return powerScaleIntegral(middleX, tension, maxExponent, p1x, p1y, middleX, middleY) + powerScaleIntegral(input, -tension, maxExponent, middleX, middleY, p2x, p2y);
+        }
+        else
+        {
+            return powerScaleIntegral(input, tension, maxExponent, p1x, p1y, middleX, middleY);
+        }
+    }
+    case StairsCurve:
+    {
+        if (tension == 0) //straight line
+        {
+            return powerScaleIntegral(input, tension, maxExponent, p1x, p1y, p2x, p2y);
+        }
+
+        const int numSteps = getStairsStepCount(tension);
+
+        const T stepX = deltaX / (tensionIsPositive ? numSteps : numSteps - 1);
+        const T stepY = deltaY / (tensionIsPositive ? numSteps - 1 : numSteps);
+
+        //with a negative tension, the first step is already one step above p1y
+        const int firstStep = tensionIsPositive ? 0 : 1;
+
+        const T steps = (input - p1x) / stepX;
+        const int step = wolf::clamp(static_cast<int>(std::floor(steps)), 0, numSteps - 1 - firstStep);
+        const T fraction = steps - step;
+
+        //the full steps at the left of the input, then the part of the current step
+        const T fullSteps = step * (p1y + firstStep * stepY) + stepY * step * (step - 1) / 2;
+
+        return stepX * (fullSteps + fraction * (p1y + (step + firstStep) * stepY));
+    }
+    case WaveCurve:
+    {
+        const T position = (input - p1x) / deltaX;
+        const T angularFrequency = getWaveFrequency(tension) * 2 * wolf::pi<T>();
+
+        T wave;
+
+        if (tensionIsPositive)
+        {
+            wave = position / 2 - std::sin(angularFrequency * position) / (2 * angularFrequency);
+        }
+        else
+        {
+            wave = getAsinWaveIntegralTable().getIntegralAt(angularFrequency * position) / angularFrequency;
+        }
+
+        return deltaX * (wave * deltaY + p1y * position);
+    }
+    default:
+        return (input * input - p1x * p1x) / 2;
+    }
+}
+
+template <typename T>
+T GraphBase::getOutDerivative(T input, T tension, T p1x, T p1y, T p2x, T p2y, CurveType type)
+{
+    if (p1x == p2x)
+    {
+        return 0;
+    }
+
+    input = std::abs(input);
+    tension = shapeTension(tension);
+
+    const bool tensionIsPositive = tension >= 0;
+
+    const T deltaX = p2x - p1x;
+    const T deltaY = p2y - p1y;
+
+    const T maxExponent = 15;
+
+    switch (type)
+    {
+    case SingleCurve:
+    {
+        return powerScaleDerivative(input, tension, maxExponent, p1x, p1y, p2x, p2y);
+    }
+    case DoubleCurve:
+    {
+        const T middleX = p1x + deltaX / 2;
+        const T middleY = p1y + deltaY / 2;
+
+        if (input > middleX)
+        {
+            return powerScaleDerivative(input, -tension, maxExponent, middleX, middleY, p2x, p2y);
+        }
+        else
+        {
+            return powerScaleDerivative(input, tension, maxExponent, p1x, p1y, middleX, middleY);
+        }
+    }
+    case StairsCurve:
+    {
+        if (tension == 0) //straight line
+        {
+            return deltaY / deltaX;
+        }
+
+        return 0;
+    }
+    case WaveCurve:
+    {
+        const T position = (input - p1x) / deltaX;
+        const T angularFrequency = getWaveFrequency(tension) * 2 * wolf::pi<T>();
+        const T angle = angularFrequency * position;
+
+        T slope;
+
+        if (tensionIsPositive)
+        {
+            slope = std::sin(angle) / 2;
+        }
+        else
+        {
+            //simplified derivative of asin(sin^2(angle / 2)), which stays finite at the peaks
+            const T halfSine = std::sin(angle / 2);
+            const T halfCosineSign = std::cos(angle / 2) >= 0 ? 1 : -1;
+
+            slope = wolf::twoOverPi<T>() * halfCosineSign * halfSine / std::sqrt(1 + halfSine * halfSine);
+        }
+
+        return slope * angularFrequency * deltaY / deltaX;
+    }
+    default:
+        return 1;
+    }
+}
+
+void GraphBase::invalidateSegmentGrid()
+{
+    segmentGridDirty = true;
+
+    invalidateIntegrals();
+}
+
+float GraphBase::getCurveDetail(float tension, CurveType type)
+{
+    tension = shapeTension(tension);
+
+    switch (type)
+    {
+    case DoubleCurve:
+        return 2;
+    case StairsCurve:
+        return tension == 0 ? 1 : getStairsStepCount(tension);
+    case WaveCurve:
+        return getWaveFrequency(tension);
+    default:
+        return 1;
+    }
+}
+
+void GraphBase::invalidateIntegrals()
+{
+    integralsDirty = true;
+    ++revision;
+}
+
+void GraphBase::rebuildIntegrals()
+{
+    double integral = 0.0;
+
+    for (int i = 0; i < vertexCount; ++i)
+    {
+        if (i > 0)
+        {
+            Vertex &leftVertex = vertices[i - 1];
+            Vertex &rightVertex = vertices[i];
+
+            const double p2x = rightVertex.getX();
+
+            integral += getOutIntegral<double>(p2x, leftVertex.getTension(), leftVertex.getX(), leftVertex.getY(), p2x, rightVertex.getY(), leftVertex.getType());
+        }
+
+        vertices[i].integral = integral;
+    }
+
+    integralsDirty = false;
+}
+
+void GraphBase::rebuildSegmentGrid()
+{
+    int segment = 0;
+
+    //segmentGridSize is a power of two, so the multiplication is exact and agrees with the lookup
+    for (int bucket = 0; bucket <= segmentGridSize; ++bucket)
+    {
+        while (segment < vertexCount - 2 && vertices[segment + 1].getX() * segmentGridSize <= bucket)
+            ++segment;
+
+        segmentGrid[bucket] = segment;
+    }
+
+    segmentGridDirty = false;
+}
+
+template <typename T>
+int GraphBase::findSegment(T x)
+{
+    if (segmentGridDirty)
+        rebuildSegmentGrid();
+
+    const int bucket = x * segmentGridSize;
+
+    int left = segmentGrid[bucket];
+    int right = bucket < segmentGridSize ? segmentGrid[bucket + 1] : left;
+
+    if (right - left <= linearSearchMaxVertices)
+    {
+        while (left < right && static_cast<T>(vertices[left + 1].getX()) <= x)
+            ++left;
+
+        return left;
+    }
+
+    //lots of vertices packed in the same bucket
+    while (left < right)
+    {
+        const int mid = left + (right - left + 1) / 2;
+
+        if (static_cast<T>(vertices[mid].getX()) <= x)
+            left = mid;
         else
-            return x >= 0 ? vertices[mid].getY() : -vertices[mid].getY();
+            right = mid - 1;
     }
 
-    const float p1x = vertices[left - 1].getX();
-    const float p1y = vertices[left - 1].getY();
+    return left;
+}
+
+template <typename T>
+T GraphBase::getValueInSegment(T x, T absX, int segment)
+{
+    Vertex &leftVertex = vertices[segment];
+    Vertex &rightVertex = vertices[segment + 1];
+
+    const T p1x = leftVertex.getX();
+    const T p1y = leftVertex.getY();
+
+    const T p2x = rightVertex.getX();
+    const T p2y = rightVertex.getY();
+
+    if (absX == p1x)
+        return x >= 0 ? p1y : -p1y;
+
+    if (absX == p2x)
+        return x >= 0 ? p2y : -p2y;
+
+    return getOutValue<T>(x, leftVertex.getTension(), p1x, p1y, p2x, p2y, leftVertex.getType());
+}
+
+template <typename T>
+T GraphBase::getValueAt(T x)
+{
+    const T absX = std::abs(x);
+
+    DISTRHO_SAFE_ASSERT_RETURN(absX <= 1, x);
+
+    //a graph without storage has no curve, so it passes the input through
+    if (vertexCount < 2)
+        return x;
+
+    return getValueInSegment(x, absX, findSegment(absX));
+}
+
+template <typename T>
+T GraphBase::getValueAt(T x, int &segmentHint)
+{
+    const T absX = std::abs(x);
+
+    DISTRHO_SAFE_ASSERT_RETURN(absX <= 1, x);
+
+    if (vertexCount < 2)
+        return x;
+
+    int segment = segmentHint;
+
+    if (segmentGridDirty || segment < 0 || segment > vertexCount - 2 || static_cast<T>(vertices[segment].getX()) > absX)
+    {
+        segment = findSegment(absX);
+    }
+    else
+    {
+        while (segment < vertexCount - 2 && static_cast<T>(vertices[segment + 1].getX()) <= absX)
+            ++segment;
+    }
+
+    segmentHint = segment;
+
+    return getValueInSegment(x, absX, segment);
+}
+
+template <typename T>
+T GraphBase::getAntiderivativeAt(T x)
+{
+    const T absX = std::abs(x);
+
+    DISTRHO_SAFE_ASSERT_RETURN(absX <= 1, x * x / 2);
+
+    if (vertexCount < 2)
+        return x * x / 2;
+
+    if (integralsDirty)
+        rebuildIntegrals();
+
+    const int segment = findSegment(absX);
+
+    Vertex &leftVertex = vertices[segment];
+    Vertex &rightVertex = vertices[segment + 1];
 
-    const float p2x = vertices[left].getX();
-    const float p2y = vertices[left].getY();
+    const T integral = getOutIntegral<T>(absX, leftVertex.getTension(), leftVertex.getX(), leftVertex.getY(), rightVertex.getX(), rightVertex.getY(), leftVertex.getType());
 
-    return getOutValue(x, vertices[left - 1].getTension(), p1x, p1y, p2x, p2y, vertices[left - 1].getType());
+    return static_cast<T>(leftVertex.integral) + integral;
 }
 
-void Graph::setHorizontalWarpAmount(float warp)
+template <typename T>
+T GraphBase::getDerivativeAt(T x)
+{
+    const T absX = std::abs(x);
+
+    DISTRHO_SAFE_ASSERT_RETURN(absX <= 1, 1);
+
+    if (vertexCount < 2)
+        return 1;
+
+    const int segment = findSegment(absX);
+
+    Vertex &leftVertex = vertices[segment];
+    Vertex &rightVertex = vertices[segment + 1];
+
+    return getOutDerivative<T>(absX, leftVertex.getTension(), leftVertex.getX(), leftVertex.getY(), rightVertex.getX(), rightVertex.getY(), leftVertex.getType());
+}
+
+template float GraphBase::getOutValue<float>(float input, float tension, float p1x, float p1y, float p2x, float p2y, CurveType type);
+template double GraphBase::getOutValue<double>(double input, double tension, double p1x, double p1y, double p2x, double p2y, CurveType type);
+
+template float GraphBase::getValueAt<float>(float x);
+template double GraphBase::getValueAt<double>(double x);
+
+template float GraphBase::getValueAt<float>(float x, int &segmentHint);
+template double GraphBase::getValueAt<double>(double x, int &segmentHint);
+
+template float GraphBase::getOutIntegral<float>(float input, float tension, float p1x, float p1y, float p2x, float p2y, CurveType type);
+template double GraphBase::getOutIntegral<double>(double input, double tension, double p1x, double p1y, double p2x, double p2y, CurveType type);
+
+template float GraphBase::getOutDerivative<float>(float input, float tension, float p1x, float p1y, float p2x, float p2y, CurveType type);
+template double GraphBase::getOutDerivative<double>(double input, double tension, double p1x, double p1y, double p2x, double p2y, CurveType type);
+
+template float GraphBase::getAntiderivativeAt<float>(float x);
+template double GraphBase::getAntiderivativeAt<double>(double x);
+
+template float GraphBase::getDerivativeAt<float>(float x);
+template double GraphBase::getDerivativeAt<double>(double x);
+
+void GraphBase::setHorizontalWarpAmount(float warp)
 {
+    //the warp is set from smoothed parameters every block, so only an actual change rebuilds the curve
+    if (this->horizontalWarpAmount == warp)
+        return;
+
     this->horizontalWarpAmount = warp;
+    invalidateSegmentGrid();
 }
 
-float Graph::getHorizontalWarpAmount() const
+float GraphBase::getHorizontalWarpAmount() const
 {
     return this->horizontalWarpAmount;
 }
 
-void Graph::setVerticalWarpAmount(float warp)
+void GraphBase::setVerticalWarpAmount(float warp)
 {
+    if (this->verticalWarpAmount == warp)
+        return;
+
     this->verticalWarpAmount = warp;
+    invalidateIntegrals();
 }
 
-float Graph::getVerticalWarpAmount() const
+float GraphBase::getVerticalWarpAmount() const
 {
     return this->verticalWarpAmount;
 }
 
-void Graph::setHorizontalWarpType(WarpType warpType)
+void GraphBase::setHorizontalWarpType(WarpType warpType)
 {
+    if (this->horizontalWarpType == warpType)
+        return;
+
     this->horizontalWarpType = warpType;
+    invalidateSegmentGrid();
 }
 
-WarpType Graph::getHorizontalWarpType() const
+WarpType GraphBase::getHorizontalWarpType() const
 {
     return this->horizontalWarpType;
 }
 
-void Graph::setVerticalWarpType(WarpType warpType)
+void GraphBase::setVerticalWarpType(WarpType warpType)
 {
+    if (this->verticalWarpType == warpType)
+        return;
+
     this->verticalWarpType = warpType;
+    invalidateIntegrals();
 }
 
-WarpType Graph::getVerticalWarpType() const
+WarpType GraphBase::getVerticalWarpType() const
 {
     return this->verticalWarpType;
 }
 
-void Graph::insertVertex(float x, float y, float tension, CurveType type)
+void GraphBase::insertVertex(float x, float y, float tension, CurveType type)
 {
-    if (vertexCount == maxVertices)
+    if (vertexCount == capacity)
         return;
 
     int i = vertexCount;
@@ -499,9 +1094,11 @@ void Graph::insertVertex(float x, float y, float tension, CurveType type)
     vertices[i] = vertex;
 
     ++vertexCount;
+
+    invalidateSegmentGrid();
 }
 
-void Graph::removeVertex(int index)
+void GraphBase::removeVertex(int index)
 {
     --vertexCount;
 
@@ -509,37 +1106,52 @@ void Graph::removeVertex(int index)
     {
         vertices[i] = vertices[i + 1];
     }
+
+    invalidateSegmentGrid();
 }
 
-void Graph::setTensionAtIndex(int index, float tension)
+void GraphBase::setTensionAtIndex(int index, float tension)
 {
     vertices[index].setTension(tension);
 }
 
-Vertex *Graph::getVertexAtIndex(int index)
+unsigned int GraphBase::getRevision() const
+{
+    return revision;
+}
+
+Vertex *GraphBase::getVertexAtIndex(int index)
 {
     DISTRHO_SAFE_ASSERT(index < vertexCount);
 
     return &vertices[index];
 }
 
-int Graph::getVertexCount()
+int GraphBase::getVertexCount()
 {
     return vertexCount;
 }
 
-bool Graph::getBipolarMode()
+int GraphBase::getVertexCapacity() const
+{
+    return capacity;
+}
+
+bool GraphBase::getBipolarMode()
 {
     return bipolarMode;
 }
 
-void Graph::setBipolarMode(bool bipolarMode)
+void GraphBase::setBipolarMode(bool bipolarMode)
 {
     this->bipolarMode = bipolarMode;
 }
 
-const char *Graph::serialize()
+const char *GraphBase::serialize()
 {
+    if (capacity == 0)
+        return "";
+
     Vertex vertex;
 
     int length = 0;
@@ -559,12 +1171,14 @@ const char *Graph::serialize()
     return serializationBuffer;
 }
 
-void Graph::clear()
+void GraphBase::clear()
 {
     vertexCount = 0;
+
+    invalidateSegmentGrid();
 }
 
-void Graph::rebuildFromString(const char *serializedGraph)
+void GraphBase::rebuildFromString(const char *serializedGraph)
 {
     char *rest = (char *)serializedGraph;
 
@@ -572,6 +1186,8 @@ void Graph::rebuildFromString(const char *serializedGraph)
 
     do
     {
+        DISTRHO_SAFE_ASSERT_BREAK(i < capacity);
+
         const float x = wolf::parseHexFloat(rest, &rest);
         const float y = wolf::parseHexFloat(++rest, &rest);
         const float tension = wolf::parseHexFloat(++rest, &rest);
@@ -584,6 +1200,8 @@ void Graph::rebuildFromString(const char *serializedGraph)
     } while (strcmp(++rest, "\0") != 0);
 
     vertexCount = i;
+
+    invalidateSegmentGrid();
 }
 } // namespace wolf
 
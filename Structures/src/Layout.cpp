@@ -1,5 +1,8 @@
 #include "Layout.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 
 START_NAMESPACE_DISTRHO
 
@@ -35,11 +38,13 @@ RelativePosition::RelativePosition(int left, int right, int top, int bottom) : l
 LayoutItem::LayoutItem(Layout *parent, Widget *widget) : fWidget(widget),
 														 fParent(parent),
 														 fAnchors(),
-														 fRelativePos()
+														 fRelativePos(),
+														 fGrow(0.0f),
+														 fShrink(1.0f)
 {
 }
 
-Widget *LayoutItem::getWidget()
+Widget *LayoutItem::getWidget() const
 {
 	return fWidget;
 }
@@ -119,6 +124,26 @@ RelativePosition LayoutItem::getRelativePos()
 	return fRelativePos;
 }
 
+LayoutItem &LayoutItem::setFlex(const float grow, const float shrink)
+{
+	fGrow = std::max(0.0f, grow);
+	fShrink = std::max(0.0f, shrink);
+
+	fParent->onItemChanged(*this);
+
+	return *this;
+}
+
+float LayoutItem::getGrow()
+{
+	return fGrow;
+}
+
+float LayoutItem::getShrink()
+{
+	return fShrink;
+}
+
 Layout::Layout(Widget *parent) : Widget(parent)
 {
 	setSize(parent->getSize());
@@ -138,6 +163,8 @@ LayoutItem &LayoutItem::setSize(const uint width, const uint height)
 	fRelativePos.right = fParent->getWidth() - (fRelativePos.left + fWidget->getWidth());
 	fRelativePos.bottom = fParent->getHeight() - (fRelativePos.top + fWidget->getHeight());
 
+	fParent->onItemResized(*this);
+
 	return *this;
 }
 
@@ -190,6 +217,31 @@ void Layout::onItemAdded(const LayoutItem &)
 {
 }
 
+void Layout::onItemChanged(const LayoutItem &)
+{
+}
+
+void Layout::onItemResized(const LayoutItem &)
+{
+}
+
+void Layout::applyGeometry()
+{
+	DISTRHO_SAFE_ASSERT_RETURN(fGeometry.size() == fItems.size(), );
+
+	for (size_t i = 0; i < fItems.size(); ++i)
+	{
+		Widget *widget = fItems[i].getWidget();
+		const Rectangle<int> &rect = fGeometry[i];
+
+		if (widget->getAbsoluteX() != rect.getX() || widget->getAbsoluteY() != rect.getY())
+			widget->setAbsolutePos(rect.getX(), rect.getY());
+
+		if ((int)widget->getWidth() != rect.getWidth() || (int)widget->getHeight() != rect.getHeight())
+			widget->setSize(rect.getWidth(), rect.getHeight());
+	}
+}
+
 RelativeLayout::RelativeLayout(Widget *parent) : Layout(parent)
 {
 }
@@ -205,49 +257,40 @@ void RelativeLayout::repositionItems()
 
 void RelativeLayout::repositionItems(Size<uint> oldSize, Size<uint> newSize)
 {
-	int absX = getAbsoluteX();
-	int absY = getAbsoluteY();
+	const int absX = getAbsoluteX();
+	const int absY = getAbsoluteY();
+
+	const int deltaWidth = newSize.getWidth() - oldSize.getWidth();
+	const int deltaHeight = newSize.getHeight() - oldSize.getHeight();
+
+	fGeometry.resize(getItemCount());
 
 	for (uint i = 0; i < getItemCount(); ++i)
 	{
-		LayoutItem *item = getItem(i);
-		const Anchors anchors = item->getAnchors();
-
-		int deltaWidth = newSize.getWidth() - oldSize.getWidth();
-		int deltaHeight = newSize.getHeight() - oldSize.getHeight();
+		LayoutItem &item = fItems[i];
+		const Anchors anchors = item.getAnchors();
+		const RelativePosition pos = item.getRelativePos();
 
+		//the sides which are not anchored follow the resize
 		if (!anchors.right)
-		{
-			int right = item->getRelativePos().right;
-
-			item->setRelativeRight(right + deltaWidth);
-		}
+			item.setRelativeRight(pos.right + deltaWidth);
 		else if (!anchors.left)
-		{
-			int left = item->getRelativePos().left;
-
-			item->setRelativeLeft(left + deltaWidth);
-		}
-
-		item->getWidget()->setAbsoluteX(absX + item->getRelativePos().left);
-		item->getWidget()->setWidth(getWidth() - item->getRelativePos().left - item->getRelativePos().right);
+			item.setRelativeLeft(pos.left + deltaWidth);
 
 		if (!anchors.bottom)
-		{
-			int bottom = item->getRelativePos().bottom;
-
-			item->setRelativeBottom(bottom + deltaHeight);
-		}
+			item.setRelativeBottom(pos.bottom + deltaHeight);
 		else if (!anchors.top)
-		{
-			int top = item->getRelativePos().top;
+			item.setRelativeTop(pos.top + deltaHeight);
 
-			item->setRelativeTop(top + deltaHeight);
-		}
+		const RelativePosition newPos = item.getRelativePos();
 
-		item->getWidget()->setAbsoluteY(absY + item->getRelativePos().top);
-		item->getWidget()->setHeight(getHeight() - item->getRelativePos().top - item->getRelativePos().bottom);
+		fGeometry[i] = Rectangle<int>(absX + newPos.left,
+									  absY + newPos.top,
+									  std::max(0, (int)getWidth() - newPos.left - newPos.right),
+									  std::max(0, (int)getHeight() - newPos.top - newPos.bottom));
 	}
+
+	applyGeometry();
 }
 
 void RelativeLayout::onResize(const ResizeEvent &ev)
@@ -260,13 +303,17 @@ void RelativeLayout::onPositionChanged(const PositionChangedEvent &)
 	const int absX = getAbsoluteX();
 	const int absY = getAbsoluteY();
 
+	fGeometry.resize(getItemCount());
+
 	for (uint i = 0; i < getItemCount(); ++i)
 	{
-		LayoutItem *item = getItem(i);
+		LayoutItem &item = fItems[i];
+		Widget *widget = item.getWidget();
 
-		item->getWidget()->setAbsoluteX(absX + item->getRelativePos().left);
-		item->getWidget()->setAbsoluteY(absY + item->getRelativePos().top);
+		fGeometry[i] = Rectangle<int>(absX + item.getRelativePos().left, absY + item.getRelativePos().top, widget->getWidth(), widget->getHeight());
 	}
+
+	applyGeometry();
 }
 
 StackLayout::StackLayout(Widget *parent) : Layout(parent)
@@ -284,14 +331,19 @@ void StackLayout::repositionItems()
 
 	int accumulatedWidth = 0;
 
+	fGeometry.resize(getItemCount());
+
 	for (size_t i = 0; i < getItemCount(); ++i)
 	{
 		LayoutItem &layoutItem = fItems[i];
 		Widget *widget = layoutItem.getWidget();
-		widget->setAbsolutePos(absX + accumulatedWidth + layoutItem.getRelativePos().left, absY + layoutItem.getRelativePos().top);
 
-		accumulatedWidth += fItems[i].getWidget()->getWidth();
+		fGeometry[i] = Rectangle<int>(absX + accumulatedWidth + layoutItem.getRelativePos().left, absY + layoutItem.getRelativePos().top, widget->getWidth(), widget->getHeight());
+
+		accumulatedWidth += widget->getWidth();
 	}
+
+	applyGeometry();
 }
 
 void StackLayout::onResize(const ResizeEvent &ev)
@@ -305,4 +357,250 @@ void StackLayout::onPositionChanged(const PositionChangedEvent &)
 }
 
 
+FlexLayout::FlexLayout(Widget *parent) : Layout(parent),
+										 fDirection(Row),
+										 fWrap(false),
+										 fGap(0),
+										 fJustifyContent(Start),
+										 fAlignItems(Start),
+										 fBasis(),
+										 fDirty(true)
+{
+}
+
+FlexLayout::FlexLayout(Window &parent) : Layout(parent),
+										 fDirection(Row),
+										 fWrap(false),
+										 fGap(0),
+										 fJustifyContent(Start),
+										 fAlignItems(Start),
+										 fBasis(),
+										 fDirty(true)
+{
+}
+
+void FlexLayout::onDisplay()
+{
+}
+
+void FlexLayout::setDirection(Direction direction)
+{
+	fDirection = direction;
+	fDirty = true;
+}
+
+void FlexLayout::setWrap(bool wrap)
+{
+	fWrap = wrap;
+	fDirty = true;
+}
+
+void FlexLayout::setGap(int gap)
+{
+	fGap = std::max(0, gap);
+	fDirty = true;
+}
+
+void FlexLayout::setJustifyContent(Alignment alignment)
+{
+	DISTRHO_SAFE_ASSERT_RETURN(alignment != Stretch, );
+
+	fJustifyContent = alignment;
+	fDirty = true;
+}
+
+void FlexLayout::setAlignItems(Alignment alignment)
+{
+	DISTRHO_SAFE_ASSERT_RETURN(alignment != SpaceBetween, );
+
+	fAlignItems = alignment;
+	fDirty = true;
+}
+
+void FlexLayout::onItemAdded(const LayoutItem &)
+{
+	//most widgets are only sized after being added, so the basis is measured at the next relayout
+	fDirty = true;
+}
+
+void FlexLayout::onItemChanged(const LayoutItem &)
+{
+	fDirty = true;
+}
+
+void FlexLayout::onItemResized(const LayoutItem &item)
+{
+	const size_t index = &item - fItems.data();
+
+	DISTRHO_SAFE_ASSERT_RETURN(index < getItemCount(), );
+
+	fBasis.resize(getItemCount());
+	fBasis[index] = item.getWidget()->getSize();
+
+	fDirty = true;
+}
+
+void FlexLayout::measureItems()
+{
+	const size_t laidOutCount = std::min(fGeometry.size(), getItemCount());
+
+	fBasis.resize(getItemCount());
+
+	for (size_t i = 0; i < getItemCount(); ++i)
+	{
+		const Size<uint> size = fItems[i].getWidget()->getSize();
+
+		//the new items, and the ones resized by someone else since the last layout, take their current size
+		if (i >= laidOutCount || (int)size.getWidth() != fGeometry[i].getWidth() || (int)size.getHeight() != fGeometry[i].getHeight())
+			fBasis[i] = size;
+	}
+}
+
+void FlexLayout::onResize(const ResizeEvent &)
+{
+	fDirty = true;
+
+	relayout();
+}
+
+void FlexLayout::onPositionChanged(const PositionChangedEvent &)
+{
+	fDirty = true;
+
+	relayout();
+}
+
+void FlexLayout::relayout()
+{
+	if (!fDirty)
+		return;
+
+	fDirty = false;
+
+	measureItems();
+
+	const bool row = fDirection == Row;
+	const float mainSize = row ? getWidth() : getHeight();
+	const float crossSize = row ? getHeight() : getWidth();
+
+	fGeometry.resize(getItemCount());
+
+	if (!fWrap)
+	{
+		if (getItemCount() > 0)
+			layoutLine(0, getItemCount(), mainSize, 0.0f, crossSize);
+
+		applyGeometry();
+
+		return;
+	}
+
+	//break the items into lines which fit the main axis, stacked along the cross axis
+	float crossPosition = 0.0f;
+	size_t first = 0;
+
+	while (first < getItemCount())
+	{
+		size_t last = first;
+		float lineMain = 0.0f;
+		float lineCross = 0.0f;
+
+		while (last < getItemCount())
+		{
+			const Size<uint> basis = fBasis[last];
+			const float itemMain = row ? basis.getWidth() : basis.getHeight();
+			const float itemCross = row ? basis.getHeight() : basis.getWidth();
+			const float needed = (last > first ? fGap : 0) + itemMain;
+
+			if (last > first && lineMain + needed > mainSize)
+				break;
+
+			lineMain += needed;
+			lineCross = std::max(lineCross, itemCross);
+			++last;
+		}
+
+		layoutLine(first, last, mainSize, crossPosition, lineCross);
+
+		crossPosition += lineCross + fGap;
+		first = last;
+	}
+
+	applyGeometry();
+}
+
+void FlexLayout::layoutLine(size_t first, size_t last, float mainSize, float crossPosition, float crossSize)
+{
+	const bool row = fDirection == Row;
+	const size_t count = last - first;
+
+	float basisSum = (float)fGap * (count - 1);
+	float growSum = 0.0f;
+	float shrinkSum = 0.0f;
+
+	for (size_t i = first; i < last; ++i)
+	{
+		const float basis = row ? fBasis[i].getWidth() : fBasis[i].getHeight();
+
+		basisSum += basis;
+		growSum += fItems[i].getGrow();
+		shrinkSum += fItems[i].getShrink() * basis;
+	}
+
+	float freeSpace = mainSize - basisSum;
+
+	//what is left after growing the items goes around them
+	float position = 0.0f;
+	float gap = fGap;
+
+	if (freeSpace > 0.0f && growSum == 0.0f)
+	{
+		if (fJustifyContent == Center)
+			position = freeSpace / 2.0f;
+		else if (fJustifyContent == End)
+			position = freeSpace;
+		else if (fJustifyContent == SpaceBetween && count > 1)
+			gap += freeSpace / (count - 1);
+	}
+
+	const int absX = getAbsoluteX();
+	const int absY = getAbsoluteY();
+
+	for (size_t i = first; i < last; ++i)
+	{
+		LayoutItem &item = fItems[i];
+
+		const float basis = row ? fBasis[i].getWidth() : fBasis[i].getHeight();
+		float itemMain = basis;
+
+		if (freeSpace > 0.0f && growSum > 0.0f)
+			itemMain += freeSpace * item.getGrow() / growSum;
+		else if (freeSpace < 0.0f && shrinkSum > 0.0f)
+			itemMain = std::max(0.0f, itemMain + freeSpace * item.getShrink() * basis / shrinkSum);
+
+		float itemCross = row ? fBasis[i].getHeight() : fBasis[i].getWidth();
+		float itemCrossPosition = crossPosition;
+
+		if (fAlignItems == Stretch)
+			itemCross = crossSize;
+		else if (fAlignItems == Center)
+			itemCrossPosition += (crossSize - itemCross) / 2.0f;
+		else if (fAlignItems == End)
+			itemCrossPosition += crossSize - itemCross;
+
+		//round the edges rather than the sizes, so that rounding errors don't add up along the line
+		const int mainStart = std::round(position);
+		const int mainEnd = std::round(position + itemMain);
+		const int crossStart = std::round(itemCrossPosition);
+		const int crossEnd = std::round(itemCrossPosition + itemCross);
+
+		if (row)
+			fGeometry[i] = Rectangle<int>(absX + mainStart, absY + crossStart, mainEnd - mainStart, crossEnd - crossStart);
+		else
+			fGeometry[i] = Rectangle<int>(absX + crossStart, absY + mainStart, crossEnd - crossStart, mainEnd - mainStart);
+
+		position += itemMain + gap;
+	}
+}
+
 END_NAMESPACE_DISTRHO
@@ -0,0 +1,244 @@
+/**
+ * Offline aliasing analysis of the waveshaper.
+ *
+ * Renders a stepped sine sweep through a graph, with every oversampling ratio, with and without
+ * antiderivative anti-aliasing, and reports the aliasing, the harmonic distortion and the CPU time of each configuration.
+ * Runs headless: build it with `make analysis` and run `./analysis`.
+ *
+ * The test frequencies fall exactly on FFT bins, so no window is needed: the harmonics land on multiples of the
+ * fundamental bin, and anything else (except DC) is aliasing or filter noise.
+ */
+
+#include "../Graph.hpp"
+#include "../AntialiasedWaveshaper.hpp"
+#include "../Oversampler.hpp"
+#include "Mathf.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <vector>
+
+USE_NAMESPACE_DISTRHO
+
+static const double sampleRate = 44100.0;
+
+//must be a power of two
+static const int fftSize = 8192;
+
+//samples rendered before the analyzed frame, to let the filters of the oversampler settle
+static const int warmupSize = 4096;
+
+static const int blockSize = 256;
+
+//prime bin numbers, so that the harmonics of a test tone rarely fold back onto each other
+static const int testBins[] = {23, 53, 113, 233, 463, 929, 1409, 1861, 2333, 2801, 3257};
+
+static const int ratios[] = {1, 2, 4, 8, 16};
+
+static const float inputGain = 0.9f;
+
+struct Measurement
+{
+    double aliasing;
+    double distortion;
+};
+
+struct Configuration
+{
+    int ratio;
+    bool antialiased;
+
+    double worstAliasing;
+    double meanAliasing;
+    double meanDistortion;
+    double nanosecondsPerSample;
+};
+
+static void fft(std::vector<std::complex<double>> &buffer)
+{
+    const int size = buffer.size();
+
+    for (int i = 1, j = 0; i < size; ++i)
+    {
+        int bit = size >> 1;
+
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+
+        j ^= bit;
+
+        if (i < j)
+            std::swap(buffer[i], buffer[j]);
+    }
+
+    for (int length = 2; length <= size; length <<= 1)
+    {
+        const double angle = -2 * wolf::pi<double>() / length;
+        const std::complex<double> rotation(std::cos(angle), std::sin(angle));
+
+        for (int i = 0; i < size; i += length)
+        {
+            std::complex<double> twiddle(1.0);
+
+            for (int j = 0; j < length / 2; ++j)
+            {
+                const std::complex<double> even = buffer[i + j];
+                const std::complex<double> odd = buffer[i + j + length / 2] * twiddle;
+
+                buffer[i + j] = even + odd;
+                buffer[i + j + length / 2] = even - odd;
+
+                twiddle *= rotation;
+            }
+        }
+    }
+}
+
+static double toDecibels(double energyRatio)
+{
+    return 10 * std::log10(std::max(energyRatio, 1e-30));
+}
+
+static Measurement analyze(const std::vector<float> &output, int fundamentalBin)
+{
+    std::vector<std::complex<double>> spectrum(output.end() - fftSize, output.end());
+
+    fft(spectrum);
+
+    double fundamental = 0.0;
+    double harmonics = 0.0;
+    double aliasing = 0.0;
+
+    for (int bin = 1; bin < fftSize / 2; ++bin)
+    {
+        const double energy = std::norm(spectrum[bin]);
+
+        if (bin == fundamentalBin)
+            fundamental += energy;
+        else if (bin % fundamentalBin == 0)
+            harmonics += energy;
+        else
+            aliasing += energy;
+    }
+
+    Measurement measurement;
+    measurement.aliasing = toDecibels(aliasing / fundamental);
+    measurement.distortion = 100 * std::sqrt(harmonics / fundamental);
+
+    return measurement;
+}
+
+/**
+ * Render a sine through the shaper and return the time spent in the processing.
+ */
+static double render(wolf::GraphBase &graph, Oversampler &oversampler, int ratio, bool antialiased, int bin, std::vector<float> &output)
+{
+    wolf::AntialiasedWaveshaper waveshapers[2] = {wolf::AntialiasedWaveshaper(graph), wolf::AntialiasedWaveshaper(graph)};
+
+    const int length = warmupSize + fftSize;
+    const double frequency = bin * sampleRate / fftSize;
+
+    std::vector<float> input(length);
+
+    for (int i = 0; i < length; ++i)
+        input[i] = inputGain * std::sin(2 * wolf::pi<double>() * frequency * i / sampleRate);
+
+    output.resize(length);
+
+    float left[blockSize];
+    float right[blockSize];
+    float *outputs[2] = {left, right};
+
+    std::chrono::steady_clock::duration time(0);
+
+    for (int start = 0; start < length; start += blockSize)
+    {
+        const float *inputs[2] = {&input[start], &input[start]};
+
+        const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+        float **buffer = oversampler.upsample(ratio, blockSize, sampleRate, inputs);
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            for (int i = 0; i < blockSize * ratio; ++i)
+            {
+                const float x = wolf::clamp(buffer[channel][i], -1.0f, 1.0f);
+
+                buffer[channel][i] = antialiased ? waveshapers[channel].process(x) : graph.getValueAt(x);
+            }
+        }
+
+        oversampler.downsample(outputs);
+
+        time += std::chrono::steady_clock::now() - begin;
+
+        std::copy(left, left + blockSize, &output[start]);
+    }
+
+    return std::chrono::duration<double, std::nano>(time).count();
+}
+
+static Configuration measure(wolf::GraphBase &graph, int ratio, bool antialiased)
+{
+    Configuration configuration;
+    configuration.ratio = ratio;
+    configuration.antialiased = antialiased;
+    configuration.worstAliasing = -1e30;
+    configuration.meanAliasing = 0.0;
+    configuration.meanDistortion = 0.0;
+
+    const int testCount = sizeof(testBins) / sizeof(testBins[0]);
+
+    double nanoseconds = 0.0;
+    std::vector<float> output;
+
+    for (int i = 0; i < testCount; ++i)
+    {
+        Oversampler oversampler;
+
+        nanoseconds += render(graph, oversampler, ratio, antialiased, testBins[i], output);
+
+        const Measurement measurement = analyze(output, testBins[i]);
+
+        configuration.worstAliasing = std::max(configuration.worstAliasing, measurement.aliasing);
+        configuration.meanAliasing += measurement.aliasing / testCount;
+        configuration.meanDistortion += measurement.distortion / testCount;
+    }
+
+    configuration.nanosecondsPerSample = nanoseconds / (testCount * (warmupSize + fftSize) * 2);
+
+    return configuration;
+}
+
+int main()
+{
+    //a hard clipper with a soft knee, which aliases a lot when shaped naively
+    wolf::Graph graph = wolf::Graph();
+    graph.insertVertex(0.35f, 0.8f, 0.0f);
+    graph.getVertexAtIndex(1)->setTension(-40.0f);
+    graph.getVertexAtIndex(2)->setY(0.9f);
+
+    std::printf("%-6s %-6s %14s %14s %10s %12s\n", "ratio", "adaa", "worst alias dB", "mean alias dB", "THD %", "ns/sample");
+
+    for (int ratio : ratios)
+    {
+        for (int antialiased = 0; antialiased < 2; ++antialiased)
+        {
+            const Configuration configuration = measure(graph, ratio, antialiased);
+
+            std::printf("%-6d %-6s %14.1f %14.1f %10.2f %12.1f\n",
+                        configuration.ratio,
+                        configuration.antialiased ? "yes" : "no",
+                        configuration.worstAliasing,
+                        configuration.meanAliasing,
+                        configuration.meanDistortion,
+                        configuration.nanosecondsPerSample);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+#define BOOST_TEST_DYN_LINK
+
+#ifdef STAND_ALONE
+#define BOOST_TEST_MODULE Main
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include "../AnimationEngine.hpp"
+
+#include <chrono>
+#include <memory>
+
+using std::chrono::milliseconds;
+
+//in the order of Animation::EasingFunction
+static const int noEasing = 0;
+static const int easeOutPower2 = 1;
+static const int easeOutSpring = 6;
+
+BOOST_AUTO_TEST_SUITE(animation_engine_suite)
+
+BOOST_AUTO_TEST_CASE(animation_engine_linear_tween, * boost::unit_test::tolerance(0.0001f))
+{
+    std::shared_ptr<AnimationEngine> engine = std::make_shared<AnimationEngine>();
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    float value = 0.0f;
+
+    const int track = engine->createTrack(1.0f, noEasing);
+    engine->addTween(track, &value, 10.0f);
+    engine->play(track, 1, start);
+
+    engine->advance(start + milliseconds(500));
+
+    BOOST_TEST(value == 5.0f);
+    BOOST_TEST(engine->isPlaying(track));
+
+    //past the end, the tween lands exactly on its target and the track stops
+    engine->advance(start + milliseconds(1500));
+
+    BOOST_TEST(value == 10.0f);
+    BOOST_TEST(!engine->isPlaying(track));
+}
+
+BOOST_AUTO_TEST_CASE(animation_engine_backward_and_speed, * boost::unit_test::tolerance(0.0001f))
+{
+    std::shared_ptr<AnimationEngine> engine = std::make_shared<AnimationEngine>();
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    float value = 0.0f;
+
+    const int track = engine->createTrack(1.0f, noEasing);
+    engine->addTween(track, &value, 10.0f);
+    engine->seek(track, 1.0f, start);
+    engine->setSpeed(track, 2.0f);
+    engine->play(track, -1, start);
+
+    engine->advance(start + milliseconds(125));
+
+    BOOST_TEST(engine->getTime(track) == 0.75f);
+    BOOST_TEST(value == 7.5f);
+}
+
+BOOST_AUTO_TEST_CASE(animation_engine_easing_tables, * boost::unit_test::tolerance(0.0001f))
+{
+    std::shared_ptr<AnimationEngine> engine = std::make_shared<AnimationEngine>();
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    float eased = 0.0f;
+    float bezier = 0.0f;
+
+    const int easedTrack = engine->createTrack(1.0f, easeOutPower2);
+    engine->addTween(easedTrack, &eased, 1.0f);
+    engine->play(easedTrack, 1, start);
+
+    //a bezier through the diagonal is linear
+    const int bezierTrack = engine->createTrack(1.0f, engine->addCubicBezierEasing(0.25f, 0.25f, 0.75f, 0.75f));
+    engine->addTween(bezierTrack, &bezier, 1.0f);
+    engine->play(bezierTrack, 1, start);
+
+    engine->advance(start + milliseconds(500));
+
+    BOOST_TEST(eased == 0.75f);
+    BOOST_TEST(bezier == 0.5f);
+}
+
+BOOST_AUTO_TEST_CASE(animation_engine_spring_overshoots)
+{
+    std::shared_ptr<AnimationEngine> engine = std::make_shared<AnimationEngine>();
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    float value = 0.0f;
+
+    const int track = engine->createTrack(1.0f, easeOutSpring);
+    engine->addTween(track, &value, 1.0f);
+    engine->play(track, 1, start);
+
+    engine->advance(start + milliseconds(333));
+
+    BOOST_TEST(value > 1.0f);
+
+    engine->advance(start + milliseconds(1000));
+
+    BOOST_TEST(value == 1.0f);
+}
+
+BOOST_AUTO_TEST_CASE(animation_engine_clone_and_destroy, * boost::unit_test::tolerance(0.0001f))
+{
+    std::shared_ptr<AnimationEngine> engine = std::make_shared<AnimationEngine>();
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    float value = 0.0f;
+
+    const int track = engine->createTrack(1.0f, noEasing);
+    engine->addTween(track, &value, 10.0f);
+
+    const int clone = engine->cloneTrack(track);
+    engine->destroyTrack(track);
+
+    BOOST_TEST(!engine->isPlaying(track));
+
+    //the clone drives its own copy of the tween
+    engine->play(clone, 1, start);
+    engine->advance(start + milliseconds(250));
+
+    BOOST_TEST(value == 2.5f);
+
+    engine->destroyTrack(clone);
+    engine->advance(start + milliseconds(500));
+
+    BOOST_TEST(value == 2.5f);
+}
+
+BOOST_AUTO_TEST_CASE(animation_engines_are_independent, * boost::unit_test::tolerance(0.0001f))
+{
+    std::shared_ptr<AnimationEngine> first = std::make_shared<AnimationEngine>();
+    std::shared_ptr<AnimationEngine> second = std::make_shared<AnimationEngine>();
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    float firstValue = 0.0f;
+    float secondValue = 0.0f;
+
+    const int firstTrack = first->createTrack(1.0f, noEasing);
+    first->addTween(firstTrack, &firstValue, 1.0f);
+    first->play(firstTrack, 1, start);
+
+    const int secondTrack = second->createTrack(1.0f, noEasing);
+    second->addTween(secondTrack, &secondValue, 1.0f);
+    second->play(secondTrack, 1, start);
+
+    first->advance(start + milliseconds(500));
+
+    BOOST_TEST(firstValue == 0.5f);
+    BOOST_TEST(secondValue == 0.0f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,78 @@
+#define BOOST_TEST_DYN_LINK
+
+#ifdef STAND_ALONE
+#define BOOST_TEST_MODULE Main
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include "../Arena.hpp"
+#include "../Stack.hpp"
+
+#include <cstdint>
+
+BOOST_AUTO_TEST_SUITE(arena_suite)
+
+BOOST_AUTO_TEST_CASE(arena_alignment)
+{
+    wolf::Arena arena(1024);
+
+    arena.allocate(3, 1);
+    void *aligned = arena.allocate(16, 64);
+
+    BOOST_REQUIRE(aligned != nullptr);
+    BOOST_REQUIRE(reinterpret_cast<uintptr_t>(aligned) % 64 == 0);
+}
+
+BOOST_AUTO_TEST_CASE(arena_full)
+{
+    wolf::Arena arena(64);
+
+    BOOST_REQUIRE(arena.allocate(48) != nullptr);
+    BOOST_REQUIRE(arena.allocate(48) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(slab_reuses_freed_blocks)
+{
+    wolf::Arena arena(1024);
+    wolf::SlabAllocator slab(arena, sizeof(double), 2);
+
+    double *a = slab.create<double>(1.0);
+    double *b = slab.create<double>(2.0);
+
+    BOOST_REQUIRE(a != nullptr && b != nullptr);
+    BOOST_REQUIRE(slab.create<double>(3.0) == nullptr);
+
+    slab.destroy(a);
+
+    BOOST_REQUIRE(slab.getFreeCount() == 1);
+    BOOST_REQUIRE(slab.create<double>(4.0) == a);
+    BOOST_REQUIRE(*b == 2.0);
+}
+
+struct alignas(64) OverAligned
+{
+    float values[4];
+};
+
+BOOST_AUTO_TEST_CASE(slab_rejects_over_aligned_types)
+{
+    wolf::Arena arena(1024);
+    wolf::SlabAllocator slab(arena, sizeof(OverAligned), 2, 16);
+
+    BOOST_REQUIRE(slab.create<OverAligned>() == nullptr);
+    BOOST_REQUIRE(slab.getFreeCount() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(stack_in_arena)
+{
+    wolf::Arena arena(1024);
+    wolf::Stack<int> stack(arena, 3);
+
+    stack.push(1);
+    stack.push(2);
+
+    BOOST_REQUIRE(stack.pop() == 2);
+    BOOST_REQUIRE(arena.getUsed() == sizeof(int) * 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
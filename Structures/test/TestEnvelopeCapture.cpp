@@ -0,0 +1,111 @@
+#define BOOST_TEST_DYN_LINK
+
+#ifdef STAND_ALONE
+#define BOOST_TEST_MODULE Main
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include "../EnvelopeCapture.hpp"
+
+#include <cmath>
+
+START_NAMESPACE_DISTRHO
+
+struct EnvelopeCaptureTestAccess
+{
+    static void setIndices(EnvelopeCapture &capture, const uint32_t index)
+    {
+        capture.fWriteIndex = index;
+        capture.fReadIndex = index;
+    }
+};
+
+END_NAMESPACE_DISTRHO
+
+BOOST_AUTO_TEST_SUITE(envelope_capture_suite)
+
+BOOST_AUTO_TEST_CASE(envelope_capture_decimation)
+{
+    const float samples[] = {0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f, 0.7f};
+
+    EnvelopeCapture capture(8);
+    capture.setDecimation(3);
+    capture.process(samples, 7);
+
+    EnvelopeCapture::Frame frames[4];
+
+    //the last sample waits for the rest of its frame
+    BOOST_REQUIRE(capture.read(frames, 4) == 2);
+
+    capture.process(samples, 2);
+
+    BOOST_REQUIRE(capture.read(frames, 4) == 1);
+    BOOST_TEST(frames[0].max == 0.7f);
+}
+
+BOOST_AUTO_TEST_CASE(envelope_capture_values, * boost::unit_test::tolerance(0.00001f))
+{
+    const float samples[] = {-0.5f, 1.0f, 0.25f, -1.0f, 3.0f, 4.0f};
+
+    EnvelopeCapture capture(8);
+    capture.setDecimation(2);
+    capture.process(samples, 6);
+
+    EnvelopeCapture::Frame frames[3];
+
+    BOOST_REQUIRE(capture.read(frames, 3) == 3);
+
+    BOOST_TEST(frames[0].min == -0.5f);
+    BOOST_TEST(frames[0].max == 1.0f);
+    BOOST_TEST(frames[0].rms == std::sqrt(1.25f / 2));
+
+    BOOST_TEST(frames[1].min == -1.0f);
+    BOOST_TEST(frames[1].max == 0.25f);
+
+    BOOST_TEST(frames[2].min == 3.0f);
+    BOOST_TEST(frames[2].rms == std::sqrt(12.5f));
+}
+
+BOOST_AUTO_TEST_CASE(envelope_capture_indices_wrap_around)
+{
+    EnvelopeCapture capture(4);
+    capture.setDecimation(1);
+
+    EnvelopeCaptureTestAccess::setIndices(capture, UINT32_MAX - 1);
+
+    EnvelopeCapture::Frame frames[4];
+
+    for (int i = 0; i < 3; ++i)
+    {
+        const float samples[] = {(float)i, (float)i + 10.0f};
+
+        capture.process(samples, 2);
+
+        BOOST_REQUIRE(capture.read(frames, 4) == 2);
+        BOOST_TEST(frames[0].max == (float)i);
+        BOOST_TEST(frames[1].max == (float)i + 10.0f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(envelope_capture_drops_when_full)
+{
+    const float samples[] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+
+    EnvelopeCapture capture(4);
+    capture.setDecimation(1);
+    capture.process(samples, 6);
+
+    EnvelopeCapture::Frame frames[8];
+
+    //the oldest frames are kept, the newest ones didn't fit
+    BOOST_REQUIRE(capture.read(frames, 8) == 4);
+    BOOST_TEST(frames[0].max == 1.0f);
+    BOOST_TEST(frames[3].max == 4.0f);
+
+    capture.process(samples + 5, 1);
+
+    BOOST_REQUIRE(capture.read(frames, 8) == 1);
+    BOOST_TEST(frames[0].max == 6.0f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
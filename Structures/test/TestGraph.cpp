@@ -6,6 +6,10 @@
 
 #include <boost/test/unit_test.hpp>
 #include "../Graph.hpp"
+#include "../FixedPointGraph.hpp"
+#include "../AntialiasedWaveshaper.hpp"
+
+#include <cmath>
 
 BOOST_AUTO_TEST_SUITE(graph_suite)
 
@@ -52,4 +56,280 @@ BOOST_AUTO_TEST_CASE(graph_set_tension)
     BOOST_TEST(graph.getValueAt(0.35f) > graphWithTension.getValueAt(0.35f));
 }
 
-BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
+BOOST_AUTO_TEST_CASE(graph_static_capacity)
+{
+    wolf::StaticGraph<4> graph = wolf::StaticGraph<4>();
+
+    graph.insertVertex(0.2f, 0.2f);
+    graph.insertVertex(0.4f, 0.4f);
+    graph.insertVertex(0.6f, 0.6f);
+
+    BOOST_TEST(graph.getVertexCapacity() == 4);
+    BOOST_TEST(graph.getVertexCount() == 4);
+}
+
+BOOST_AUTO_TEST_CASE(graph_dynamic_capacity, * boost::unit_test::tolerance((float)0.00001))
+{
+    wolf::Arena arena(1 << 16);
+    wolf::DynamicGraph graph(arena, 8);
+
+    graph.insertVertex(0.5f, 0.75f);
+
+    BOOST_TEST(graph.getVertexCapacity() == 8);
+    BOOST_TEST(graph.getVertexCount() == 3);
+    BOOST_TEST(graph.getValueAt(0.25f) == 0.375f);
+}
+
+BOOST_AUTO_TEST_CASE(graph_dynamic_full_arena, * boost::unit_test::tolerance((float)0.00001))
+{
+    wolf::Arena arena(16);
+    wolf::DynamicGraph graph(arena, 8);
+
+    BOOST_TEST(graph.getVertexCapacity() == 0);
+    BOOST_TEST(arena.getUsed() == 0u);
+    BOOST_TEST(graph.getValueAt(0.25f) == 0.25f);
+    BOOST_TEST(graph.getValueAt(-0.5f) == -0.5f);
+}
+
+BOOST_AUTO_TEST_CASE(graph_binary_search, * boost::unit_test::tolerance((float)0.00001))
+{
+    wolf::StaticGraph<128> graph = wolf::StaticGraph<128>();
+
+    for (int i = 1; i < 100; ++i)
+    {
+        graph.insertVertex(i / 100.0f, i / 100.0f);
+    }
+
+    BOOST_TEST(graph.getVertexCount() > wolf::linearSearchMaxVertices);
+
+    BOOST_TEST(graph.getValueAt(0.505f) == 0.505f);
+    BOOST_TEST(graph.getValueAt(-0.2525f) == -0.2525f);
+    BOOST_TEST(graph.getValueAt(0.99f) == 0.99f);
+}
+
+BOOST_AUTO_TEST_CASE(graph_copy, * boost::unit_test::tolerance((float)0.00001))
+{
+    wolf::Graph graph = wolf::Graph();
+    graph.insertVertex(0.5f, 0.75f);
+
+    wolf::Graph copy = graph;
+    graph.clear();
+
+    BOOST_TEST(copy.getVertexCount() == 3);
+    BOOST_TEST(copy.getValueAt(0.25f) == 0.375f);
+}
+
+BOOST_AUTO_TEST_CASE(graph_segment_grid, * boost::unit_test::tolerance((float)0.00001))
+{
+    wolf::Graph graph = wolf::Graph();
+
+    //several vertices in the same grid cell, and one on a cell boundary
+    graph.insertVertex(0.5f, 0.5f);
+    graph.insertVertex(0.501f, 0.501f);
+    graph.insertVertex(0.502f, 0.502f);
+    graph.insertVertex(0.75f, 0.75f);
+
+    for (int i = 0; i <= 1000; ++i)
+    {
+        const float x = i / 1000.0f;
+
+        BOOST_TEST(graph.getValueAt(x) == x);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(graph_segment_grid_follows_edits, * boost::unit_test::tolerance((float)0.00001))
+{
+    wolf::Graph graph = wolf::Graph();
+
+    graph.insertVertex(0.5f, 0.5f);
+    BOOST_TEST(graph.getValueAt(0.25f) == 0.25f);
+
+    graph.getVertexAtIndex(1)->setPosition(0.25f, 0.5f);
+    BOOST_TEST(graph.getValueAt(0.25f) == 0.5f);
+    BOOST_TEST(graph.getValueAt(0.625f) == 0.75f);
+
+    graph.removeVertex(1);
+    BOOST_TEST(graph.getValueAt(0.25f) == 0.25f);
+}
+
+BOOST_AUTO_TEST_CASE(graph_segment_hint)
+{
+    wolf::Graph graph = wolf::Graph();
+
+    graph.insertVertex(0.2f, 0.6f, 40.0f);
+    graph.insertVertex(0.6f, 0.3f, -20.0f, wolf::DoubleCurve);
+
+    int segment = 0;
+
+    for (int i = 0; i <= 500; ++i)
+    {
+        const float x = i / 500.0f;
+
+        BOOST_TEST(graph.getValueAt(x, segment) == graph.getValueAt(x));
+    }
+
+    //going backwards falls back to a regular lookup
+    BOOST_TEST(graph.getValueAt(0.1f, segment) == graph.getValueAt(0.1f));
+}
+
+BOOST_AUTO_TEST_CASE(graph_double_precision, * boost::unit_test::tolerance(0.0001))
+{
+    wolf::Graph graph = wolf::Graph();
+
+    graph.insertVertex(0.3f, 0.7f, 50.0f);
+    graph.insertVertex(0.7f, 0.2f, -30.0f, wolf::WaveCurve);
+
+    for (int i = 0; i <= 100; ++i)
+    {
+        const double x = i / 100.0;
+
+        BOOST_TEST(graph.getValueAt(x) == (double)graph.getValueAt((float)x));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(graph_fixed_point)
+{
+    wolf::Graph graph = wolf::Graph();
+    graph.insertVertex(0.4f, 0.8f, 60.0f);
+
+    wolf::FixedPointGraph fixedPointGraph;
+    fixedPointGraph.bake(graph);
+
+    for (int i = -100; i <= 100; ++i)
+    {
+        const float x = i / 100.0f;
+        const int16_t y = fixedPointGraph.getValueAt(wolf::FixedPointGraph::toQ15(x));
+
+        BOOST_TEST(std::abs(wolf::FixedPointGraph::fromQ15(y) - graph.getValueAt(x)) < 0.001f);
+    }
+}
+
+static double integrate(wolf::GraphBase &graph, double x)
+{
+    const int steps = 100000;
+    const double step = x / steps;
+
+    double sum = 0.0;
+
+    for (int i = 0; i < steps; ++i)
+        sum += graph.getValueAt((i + 0.5) * step);
+
+    return sum * step;
+}
+
+BOOST_AUTO_TEST_CASE(graph_antiderivative)
+{
+    const wolf::CurveType types[] = {wolf::SingleCurve, wolf::DoubleCurve, wolf::StairsCurve, wolf::WaveCurve};
+    const float tensions[] = {0.0f, 35.0f, -35.0f, 100.0f, -100.0f};
+
+    for (wolf::CurveType type : types)
+    {
+        for (float tension : tensions)
+        {
+            wolf::Graph graph = wolf::Graph();
+
+            graph.insertVertex(0.3f, 0.6f, tension, type);
+            graph.setTensionAtIndex(0, -tension);
+            graph.getVertexAtIndex(0)->setType(type);
+
+            for (int i = 1; i <= 10; ++i)
+            {
+                const double x = i / 10.0;
+
+                BOOST_TEST(std::abs(graph.getAntiderivativeAt(x) - integrate(graph, x)) < 0.0001);
+                BOOST_TEST(graph.getAntiderivativeAt(-x) == graph.getAntiderivativeAt(x));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(graph_antiderivative_follows_edits)
+{
+    wolf::Graph graph = wolf::Graph();
+
+    const unsigned int revision = graph.getRevision();
+    BOOST_TEST(std::abs(graph.getAntiderivativeAt(1.0) - 0.5) < 0.000001);
+
+    graph.getVertexAtIndex(1)->setY(0.5f);
+
+    BOOST_TEST(graph.getRevision() != revision);
+    BOOST_TEST(std::abs(graph.getAntiderivativeAt(1.0) - 0.25) < 0.000001);
+}
+
+BOOST_AUTO_TEST_CASE(graph_unchanged_warp_keeps_revision)
+{
+    wolf::Graph graph = wolf::Graph();
+
+    graph.setHorizontalWarpType(wolf::BendPlus);
+    graph.setHorizontalWarpAmount(0.5f);
+
+    const unsigned int revision = graph.getRevision();
+
+    graph.setHorizontalWarpType(wolf::BendPlus);
+    graph.setHorizontalWarpAmount(0.5f);
+    graph.setVerticalWarpType(wolf::None);
+    graph.setVerticalWarpAmount(0.0f);
+
+    BOOST_TEST(graph.getRevision() == revision);
+
+    graph.setHorizontalWarpAmount(0.6f);
+
+    BOOST_TEST(graph.getRevision() != revision);
+}
+
+BOOST_AUTO_TEST_CASE(graph_derivative)
+{
+    const wolf::CurveType types[] = {wolf::SingleCurve, wolf::DoubleCurve, wolf::WaveCurve};
+    const float tensions[] = {0.0f, 35.0f, -35.0f, 5.0f, -5.0f};
+
+    const double h = 0.000001;
+
+    for (wolf::CurveType type : types)
+    {
+        for (float tension : tensions)
+        {
+            wolf::Graph graph = wolf::Graph();
+
+            graph.insertVertex(0.4f, 0.7f, tension, type);
+
+            for (int i = 1; i < 20; ++i)
+            {
+                //stay away from the vertex
+                if (i == 8)
+                    continue;
+
+                //and from the peaks of the waves, where the slope isn't defined
+                const double x = i / 20.0 + 0.013;
+                const double slope = (graph.getValueAt(x + h) - graph.getValueAt(x - h)) / (2 * h);
+
+                BOOST_TEST(std::abs(graph.getDerivativeAt(x) - slope) < 0.001);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(antialiased_waveshaper)
+{
+    wolf::Graph graph = wolf::Graph();
+    graph.insertVertex(0.5f, 0.8f, 40.0f, wolf::WaveCurve);
+
+    wolf::AntialiasedWaveshaper waveshaper(graph);
+
+    //a constant input gives the value of the graph
+    for (int i = 0; i < 4; ++i)
+        waveshaper.process(0.3f);
+
+    BOOST_TEST(std::abs(waveshaper.process(0.3f) - graph.getValueAt(0.3f)) < 0.0001f);
+
+    //otherwise, the average of the graph between the two inputs
+    const float average = integrate(graph, 0.9) - integrate(graph, 0.3);
+    BOOST_TEST(std::abs(waveshaper.process(0.9f) - average / 0.6f) < 0.0001f);
+
+    //editing the graph doesn't leave a stale antiderivative behind
+    graph.getVertexAtIndex(1)->setY(0.2f);
+
+    waveshaper.process(0.9f);
+    BOOST_TEST(std::abs(waveshaper.process(0.9f) - graph.getValueAt(0.9f)) < 0.0001f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,132 @@
+#define BOOST_TEST_DYN_LINK
+
+#ifdef STAND_ALONE
+#define BOOST_TEST_MODULE Main
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include "../ObjectPool.hpp"
+
+#include <vector>
+
+struct PooledVoice
+{
+    PooledVoice(int note) : note(note), resetCount(0)
+    {
+    }
+
+    void reset()
+    {
+        ++resetCount;
+    }
+
+    int note;
+    int resetCount;
+};
+
+//how many times each CountedObject was destructed, by construction order
+static std::vector<int> destructionCounts;
+
+struct CountedObject
+{
+    CountedObject() : id(destructionCounts.size())
+    {
+        destructionCounts.push_back(0);
+    }
+
+    ~CountedObject()
+    {
+        ++destructionCounts[id];
+    }
+
+    size_t id;
+};
+
+BOOST_AUTO_TEST_SUITE(object_pool_suite)
+
+BOOST_AUTO_TEST_CASE(object_pool_contiguous)
+{
+    wolf::ObjectPool<PooledVoice> pool(3, 60);
+
+    PooledVoice *a = pool.getObject();
+    PooledVoice *b = pool.getObject();
+
+    BOOST_REQUIRE(a->note == 60);
+    BOOST_REQUIRE(reinterpret_cast<char *>(b) > reinterpret_cast<char *>(a));
+    BOOST_REQUIRE(reinterpret_cast<char *>(b) - reinterpret_cast<char *>(a) < 64);
+}
+
+BOOST_AUTO_TEST_CASE(object_pool_empty)
+{
+    wolf::ObjectPool<PooledVoice> pool(1, 60);
+
+    BOOST_REQUIRE(pool.getObject() != nullptr);
+    BOOST_REQUIRE(pool.getObject() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(object_pool_reset_on_free)
+{
+    wolf::ObjectPool<PooledVoice> pool(1, 60);
+
+    PooledVoice *voice = pool.getObject();
+    pool.freeObject(voice);
+
+    BOOST_REQUIRE(voice->resetCount == 1);
+    BOOST_REQUIRE(pool.getObject() == voice);
+}
+
+BOOST_AUTO_TEST_CASE(object_pool_grow_in_chunks)
+{
+    wolf::ObjectPool<PooledVoice> pool(wolf::ObjectPool<PooledVoice>::GrowInChunks, 2, 60);
+
+    pool.getObject();
+    pool.getObject();
+
+    BOOST_REQUIRE(pool.getObject() != nullptr);
+    BOOST_REQUIRE(pool.getCapacity() == 4);
+}
+
+BOOST_AUTO_TEST_CASE(object_pool_empty_chunk)
+{
+    wolf::ObjectPool<int> pool(wolf::ObjectPool<int>::GrowInChunks, 0);
+
+    pool.reserve(3);
+
+    BOOST_REQUIRE(pool.numberObjectsLeft() >= 3);
+}
+
+BOOST_AUTO_TEST_CASE(object_pool_handle)
+{
+    wolf::ObjectPool<int> pool(2);
+
+    {
+        wolf::ObjectPool<int>::Handle handle = pool.acquire();
+
+        BOOST_REQUIRE(handle);
+        BOOST_REQUIRE(pool.numberObjectsLeft() == 1);
+    }
+
+    BOOST_REQUIRE(pool.numberObjectsLeft() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(object_pool_destroys_checked_out_objects_once)
+{
+    destructionCounts.clear();
+
+    {
+        wolf::ObjectPool<CountedObject> pool(wolf::ObjectPool<CountedObject>::GrowInChunks, 2);
+
+        pool.getObject();
+        pool.getObject();
+        pool.freeObject(pool.getObject());
+    }
+
+    BOOST_REQUIRE(destructionCounts.size() == 4);
+
+    for (size_t i = 0; i < destructionCounts.size(); ++i)
+    {
+        BOOST_REQUIRE(destructionCounts[i] == 1);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,86 @@
+#define BOOST_TEST_DYN_LINK
+
+#ifdef STAND_ALONE
+#define BOOST_TEST_MODULE Main
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include "../Ringbuffer.hpp"
+#include "../Arena.hpp"
+
+BOOST_AUTO_TEST_SUITE(ringbuffer_suite)
+
+BOOST_AUTO_TEST_CASE(ringbuffer_power_of_two)
+{
+    wolf::Ringbuffer<int> buffer(5);
+
+    BOOST_REQUIRE(buffer.capacity() == 8);
+}
+
+BOOST_AUTO_TEST_CASE(ringbuffer_overwrite_drops_oldest)
+{
+    wolf::Ringbuffer<int> buffer(4);
+
+    for (int i = 0; i < 6; ++i)
+    {
+        buffer.add(i);
+    }
+
+    BOOST_REQUIRE(buffer.count() == 4);
+    BOOST_REQUIRE(buffer.get() == 2);
+    BOOST_REQUIRE(buffer.getHistory(0) == 5);
+}
+
+BOOST_AUTO_TEST_CASE(ringbuffer_reject)
+{
+    wolf::Ringbuffer<int> buffer(2, wolf::Ringbuffer<int>::Reject);
+
+    BOOST_REQUIRE(buffer.add(1));
+    BOOST_REQUIRE(buffer.add(2));
+    BOOST_REQUIRE(!buffer.add(3));
+    BOOST_REQUIRE(buffer.peek(1) == 2);
+}
+
+BOOST_AUTO_TEST_CASE(ringbuffer_bulk_wraps_around)
+{
+    const int items[] = {1, 2, 3, 4, 5, 6};
+    int output[6] = {};
+
+    wolf::Ringbuffer<int> buffer(8);
+
+    buffer.push(items, 6);
+    buffer.pop(output, 4);
+
+    BOOST_REQUIRE(buffer.push(items, 6) == 6);
+    BOOST_REQUIRE(buffer.count() == 8);
+    BOOST_REQUIRE(buffer.pop(output, 6) == 6);
+    BOOST_REQUIRE(output[0] == 5);
+    BOOST_REQUIRE(output[2] == 1);
+    BOOST_REQUIRE(output[5] == 4);
+}
+
+BOOST_AUTO_TEST_CASE(ringbuffer_interpolated_history, * boost::unit_test::tolerance(0.00001f))
+{
+    wolf::Ringbuffer<float> buffer(4);
+
+    buffer.add(0.0f);
+    buffer.add(1.0f);
+    buffer.add(3.0f);
+
+    BOOST_TEST(buffer.getInterpolatedHistory(0.5f) == 2.0f);
+    BOOST_TEST(buffer.getInterpolatedHistory(1.25f) == 0.75f);
+}
+
+BOOST_AUTO_TEST_CASE(ringbuffer_full_arena)
+{
+    wolf::Arena arena(8);
+    wolf::Ringbuffer<int> buffer(arena, 16);
+    const int items[] = {1, 2};
+
+    BOOST_REQUIRE(buffer.capacity() == 0);
+    BOOST_REQUIRE(!buffer.add(1));
+    BOOST_REQUIRE(buffer.push(items, 2) == 0);
+    BOOST_REQUIRE(buffer.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,93 @@
+#define BOOST_TEST_DYN_LINK
+
+#ifdef STAND_ALONE
+#define BOOST_TEST_MODULE Main
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include "../StaticArray.hpp"
+#include "../Array.hpp"
+
+#include <memory>
+
+BOOST_AUTO_TEST_SUITE(static_array_suite)
+
+BOOST_AUTO_TEST_CASE(static_array_full)
+{
+    wolf::StaticArray<int, 2> array;
+
+    BOOST_REQUIRE(array.add(1));
+    BOOST_REQUIRE(array.add(2));
+    BOOST_REQUIRE(!array.add(3));
+    BOOST_REQUIRE(array.count() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(static_array_remove_range)
+{
+    const int items[] = {1, 2, 3, 4, 5};
+
+    wolf::StaticArray<int, 8> array;
+    array.addRange(items, 5);
+    array.removeRange(1, 2);
+
+    BOOST_REQUIRE(array.count() == 3);
+    BOOST_REQUIRE(array[0] == 1);
+    BOOST_REQUIRE(array[1] == 4);
+    BOOST_REQUIRE(array[2] == 5);
+}
+
+BOOST_AUTO_TEST_CASE(static_array_swap_remove)
+{
+    const int items[] = {1, 2, 3, 4};
+
+    wolf::StaticArray<int, 4> array;
+    array.addRange(items, 4);
+    array.swapRemove(0);
+
+    BOOST_REQUIRE(array.count() == 3);
+    BOOST_REQUIRE(array[0] == 4);
+}
+
+BOOST_AUTO_TEST_CASE(static_array_move_only)
+{
+    wolf::StaticArray<std::unique_ptr<int>, 4> array;
+
+    array.add(std::unique_ptr<int>(new int(1)));
+    array.add(std::unique_ptr<int>(new int(2)));
+    array.add(std::unique_ptr<int>(new int(3)));
+
+    array.remove(0);
+
+    BOOST_REQUIRE(array.count() == 2);
+    BOOST_REQUIRE(*array[0] == 2);
+    BOOST_REQUIRE(*array.pop() == 3);
+}
+
+BOOST_AUTO_TEST_CASE(static_array_get_out_of_bounds)
+{
+    wolf::StaticArray<std::unique_ptr<int>, 2> array;
+
+    BOOST_REQUIRE(array.get(0) == nullptr);
+    BOOST_REQUIRE(array.getLast() == nullptr);
+
+    array.add(std::unique_ptr<int>(new int(1)));
+
+    BOOST_REQUIRE(**array.get(0) == 1);
+    BOOST_REQUIRE(array.get(1) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(array_remove_keeps_order)
+{
+    wolf::Array<int> array(4);
+
+    array.add(1);
+    array.add(2);
+    array.add(3);
+    array.remove(0);
+
+    BOOST_REQUIRE(array.count() == 2);
+    BOOST_REQUIRE(array.get(0) == 2);
+    BOOST_REQUIRE(array.get(1) == 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,105 @@
+#!/bin/sh
+# Embed a binary file (a font, an image...) into the plugin.
+#
+# usage: embed.sh <namespace> <name> <file>
+#
+# Writes <name>.hpp, which declares <namespace>::<name> and <namespace>::<name>_size, and <name>.cpp,
+# which pulls the file in at compile time instead of spelling it out as a byte list:
+# with #embed where the compiler has it, else with the .incbin directive of the assembler.
+# <file> is written with its absolute path, so the source compiles from any directory.
+# <name>.inc holds the bytes, as a fallback for the compilers which have neither (MSVC).
+
+set -e
+
+NAMESPACE="$1"
+NAME="$2"
+FILE="$3"
+
+if [ -z "$NAMESPACE" ] || [ -z "$NAME" ] || [ ! -f "$FILE" ]; then
+    echo "usage: $0 <namespace> <name> <file>" >&2
+    exit 1
+fi
+
+#the assembler resolves .incbin against the directory the compiler runs in, not the one of the source
+FILE="$(cd "$(dirname "$FILE")" && pwd)/$(basename "$FILE")"
+
+SIZE=$(wc -c < "$FILE" | tr -d ' ')
+GUARD="BINARY_${NAMESPACE}_$(echo "$NAME" | tr '[:lower:]' '[:upper:]')_INCLUDED"
+SYMBOL="${NAMESPACE}_resource_${NAME}"
+
+cat << END > "${NAME}.hpp"
+/* (Auto-generated binary data file). */
+
+#ifndef ${GUARD}
+#define ${GUARD}
+
+namespace ${NAMESPACE}
+{
+	extern const char* ${NAME};
+	const unsigned int ${NAME}_size = ${SIZE};
+}
+
+#endif
+END
+
+cat << END > "${NAME}.cpp"
+/* (Auto-generated binary data file). */
+
+#include "${NAME}.hpp"
+
+#if defined(__has_embed)
+#if __has_embed("${FILE}")
+#define ${SYMBOL}_embed 1
+#endif
+#endif
+
+#if defined(${SYMBOL}_embed)
+
+static const unsigned char ${SYMBOL}[] = {
+#embed "${FILE}"
+};
+
+#elif defined(__GNUC__)
+
+#define ${SYMBOL}_str2(x) #x
+#define ${SYMBOL}_str(x) ${SYMBOL}_str2(x)
+
+#define ${SYMBOL}_label ${SYMBOL}_str(__USER_LABEL_PREFIX__) "${SYMBOL}"
+
+//a global symbol, so that it still links when LTO puts the asm and its users in different partitions
+#if defined(__APPLE__)
+#define ${SYMBOL}_section ".const_data\n"
+#define ${SYMBOL}_symbol ".private_extern " ${SYMBOL}_label "\n"
+#elif defined(__ELF__)
+#define ${SYMBOL}_section ".section \".rodata\"\n"
+#define ${SYMBOL}_symbol ".hidden " ${SYMBOL}_label "\n" \\
+                         ".type " ${SYMBOL}_label ", \"object\"\n" \\
+                         ".size " ${SYMBOL}_label ", ${SIZE} + 1\n"
+#else
+#define ${SYMBOL}_section ".section \".rodata\"\n"
+#define ${SYMBOL}_symbol
+#endif
+
+__asm__(${SYMBOL}_section
+        ".globl " ${SYMBOL}_label "\n"
+        ${SYMBOL}_symbol
+        ".balign 16\n"
+        ${SYMBOL}_label ":\n"
+        ".incbin \"${FILE}\"\n"
+        ".byte 0\n"
+        ".text\n");
+
+extern "C" const unsigned char ${SYMBOL}[];
+
+#else
+
+static const unsigned char ${SYMBOL}[] = {
+#include "${NAME}.inc"
+};
+
+#endif
+
+const char* ${NAMESPACE}::${NAME} = (const char*) ${SYMBOL};
+END
+
+od -An -v -tu1 "$FILE" | tr -s ' \n' ',' | sed 's/^,//; s/,$//' > "${NAME}.inc"
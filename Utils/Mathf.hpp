@@ -12,6 +12,21 @@ START_NAMESPACE_DISTRHO
 
 namespace wolf
 {
+/**
+ * Typed constants, so that float math doesn't get promoted to double.
+ */
+template <typename T>
+constexpr T pi()
+{
+    return static_cast<T>(3.14159265358979323846);
+}
+
+template <typename T>
+constexpr T twoOverPi()
+{
+    return static_cast<T>(0.63661977236758134308);
+}
+
 template <typename T,
           typename = typename std::enable_if<std::is_arithmetic<T>::value, T>::type>
 T clamp(const T &value, const T &min, const T &max)
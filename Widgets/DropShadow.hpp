@@ -1,6 +1,7 @@
 #pragma once
 
 #include "WolfWidget.hpp"
+#include "ResourceCache.hpp"
 
 START_NAMESPACE_DISTRHO
 
@@ -8,12 +9,16 @@ class DropShadow : public WolfWidget
 {
 public:
     explicit DropShadow(NanoWidget* widget, Size<uint> size) noexcept;
+    ~DropShadow();
     void onNanoDisplay() override;
 
 private:
     Size<uint> fSize;
     Point<uint> fPos;
 
+    ResourceCache *fResources;
+    const ResourceCache::Resource *fGradient;
+
     DISTRHO_LEAK_DETECTOR(DropShadow)
 };
 
@@ -0,0 +1,29 @@
+#ifndef WOLF_FONT_REGISTRY_HPP_INCLUDED
+#define WOLF_FONT_REGISTRY_HPP_INCLUDED
+
+#include "NanoVG.hpp"
+
+START_NAMESPACE_DISTRHO
+
+/**
+ * The fonts embedded in the plugin, shared by all the widgets.
+ * A font is parsed once per NanoVG context, however many widgets use it.
+ */
+class FontRegistry
+{
+public:
+  /**
+   * Make an embedded font available under @a name. Adding a name again does nothing.
+   */
+  static void add(const char *name, const char *data, uint size);
+
+  /**
+   * Get the id of the font @a name in @a context, parsing it the first time it's used with that context.
+   * Returns -1 if the font was never added.
+   */
+  static NanoVG::FontId load(NanoVG &context, const char *name);
+};
+
+END_NAMESPACE_DISTRHO
+
+#endif
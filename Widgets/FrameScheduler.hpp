@@ -0,0 +1,104 @@
+#ifndef WOLF_FRAME_SCHEDULER_DEFINED_H
+#define WOLF_FRAME_SCHEDULER_DEFINED_H
+
+#include "src/DistrhoDefines.h"
+#include "Geometry.hpp"
+#include "Widget.hpp"
+#include "Window.hpp"
+#include "Animation.hpp"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+START_NAMESPACE_DISTRHO
+
+/**
+ * Repaints the widgets of a window only when they need it, at most once per frame.
+ * Widgets mark themselves dirty instead of repainting from their own idle callbacks,
+ * and hand their animations to the scheduler while they play, so an idle window costs next to nothing.
+ * Each window has its own scheduler and animation engine, used from the thread of that window only.
+ */
+class FrameScheduler : public IdleCallback
+{
+public:
+  enum DirtyReason
+  {
+    ValueChanged = 1,
+    StateChanged = 2,
+    AnimationStep = 4,
+    InputChanged = 8,
+    Resized = 16
+  };
+
+  /**
+   * Get the scheduler of the window of @a widget, creating it if needed.
+   * A widget which attaches must detach in its destructor.
+   */
+  static FrameScheduler *attach(Widget *widget);
+  static void detach(Widget *widget);
+
+  /**
+   * Ask for @a widget to be repainted at the next frame.
+   * DGL only repaints whole widgets, so a widget is marked dirty as a whole.
+   */
+  void markDirty(Widget *widget, DirtyReason reason);
+
+  /**
+   * The engine which advances the animations of the window, to build them with.
+   */
+  AnimationEngine &getAnimationEngine();
+
+  /**
+   * Repaint @a widget once per frame until @a animation stops playing.
+   * Call it after Animation::play().
+   */
+  void runAnimation(Animation *animation, Widget *widget);
+
+  /**
+   * Why @a widget was repainted at the last frame.
+   * Lets a widget skip the work that its dirty reasons don't need.
+   */
+  int getRepaintReasons(Widget *widget) const;
+
+  void setFrameRate(float framesPerSecond);
+
+protected:
+  void idleCallback() override;
+
+private:
+  struct DirtyWidget
+  {
+    Widget *widget;
+    int reasons;
+  };
+
+  struct RunningAnimation
+  {
+    Animation *animation;
+    Widget *widget;
+  };
+
+  explicit FrameScheduler(Window &window);
+  ~FrameScheduler();
+
+  void forgetWidget(Widget *widget);
+
+  Window &fWindow;
+  int fWidgetCount;
+
+  std::shared_ptr<AnimationEngine> fAnimationEngine;
+
+  std::chrono::steady_clock::duration fFrameDuration;
+  std::chrono::steady_clock::time_point fLastFrameTime;
+
+  std::vector<DirtyWidget> fDirtyWidgets;
+  std::vector<DirtyWidget> fRepaintedWidgets;
+  std::vector<RunningAnimation> fAnimations;
+
+  DISTRHO_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FrameScheduler)
+};
+
+END_NAMESPACE_DISTRHO
+
+#endif
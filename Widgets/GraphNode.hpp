@@ -73,10 +73,18 @@ protected:
   bool onMotion(const Widget::MotionEvent &ev) override;
   bool onMouse(const Widget::MouseEvent &ev) override;
 
+  /**
+   * Compute the position of the handle, on the curve halfway between its vertex and the next one.
+   * Called by the parent whenever it rebuilds its node index.
+   */
+  void updatePosition();
+
 private:
   GraphVertex *vertex;
   Point<int> mouseDownPosition;
 
+  Point<float> position;
+
   DISTRHO_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GraphTensionHandle)
 };
 
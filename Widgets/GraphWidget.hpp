@@ -7,8 +7,13 @@
 #include "Margin.hpp"
 #include "Widget.hpp"
 #include "MenuWidget.hpp"
+#include "FrameScheduler.hpp"
+#include "OffscreenLayer.hpp"
+#include "StrokeBatch.hpp"
+#include "EnvelopeCapture.hpp"
 
 #include <array>
+#include <vector>
 
 START_NAMESPACE_DISTRHO
 
@@ -24,7 +29,6 @@ enum class GraphGradientMode
 };
 
 class GraphWidgetInner : public NanoWidget,
-                         public IdleCallback,
                          public MenuWidget::Callback
 {
   friend class GraphNode;
@@ -70,8 +74,6 @@ protected:
   bool onMotion(const MotionEvent &ev) override;
   void onFocusOut() override;
 
-  void idleCallback() override;
-
   /**
   * callback for when a right click menu item gets selected
   */
@@ -111,6 +113,16 @@ protected:
    */
   void drawBackground();
 
+  /**
+   * Sample the curve into the cached polyline, if the graph or the size of the widget changed since the last time.
+   */
+  void updateCurvePoints();
+
+  /**
+   * Get the height of the cached polyline at the horizontal position @a x, in pixels.
+   */
+  float getCurveHeightAt(float x) const;
+
   /**
    * Draw the edge associated with the specified vertex in the graph.
    */
@@ -135,6 +147,11 @@ protected:
 
   void updateInput(const float input);
 
+  /**
+   * Add the frames captured from the input of the shaper to the density of the input, which fades over time.
+   */
+  void updateInputEnvelope(const EnvelopeCapture::Frame *frames, const int count);
+
   void setGraphGradientMode(GraphGradientMode graphGradientMode);
 
   void setHorizontalWarpAmount(const float warpAmount);
@@ -147,6 +164,11 @@ protected:
 
   void positionGraphNodes();
 
+  /**
+   * Shade the area under the curve where the input has been lately, the more it sat there the higher.
+   */
+  void drawInputDensity();
+
   /**
    * Draw a vertical line to indicate the input volume on the graph.
    */
@@ -187,6 +209,17 @@ private:
 
   GraphNode *getHoveredNode(Point<int> cursorPos);
 
+  /**
+   * Rebuild the node index, if the graph or the size of the widget changed since the last time.
+   */
+  void updateNodeIndex();
+  void rebuildNodeIndex();
+
+  /**
+   * Get the node with the specified id in the node index.
+   */
+  GraphNode *getIndexedNode(int id) const;
+
   /**
    * The data structure that contains the graph. Kept synchronized with the dsp side of the plugin.
    */
@@ -195,7 +228,36 @@ private:
   /**
    * Contains the vertex widgets used in the graph.
    */
-  GraphVertex *graphVertices[wolf::maxVertices];
+  GraphVertex *graphVertices[wolf::Graph::vertexCapacity];
+
+  /**
+   * The curve as a polyline, adaptively sampled, shared by everything that draws it.
+   * Edge i goes from fCurvePoints[fEdgeStarts[i]] to fCurvePoints[fEdgeStarts[i + 1] - 1].
+   */
+  std::vector<Point<float>> fCurvePoints;
+  int fEdgeStarts[wolf::Graph::vertexCapacity];
+  float fCurvePeak;
+
+  /**
+   * What the cached polyline was sampled from.
+   */
+  unsigned int fCurveRevision;
+  uint fCurveWidth;
+  uint fCurveHeight;
+
+  /**
+   * Uniform grid over the vertices and their tension handles, so that hit testing only looks at the nodes around the cursor.
+   * Node i is graphVertices[i] and node vertexCapacity + i is its tension handle.
+   * The nodes of each cell are chained through fNextNodeInCell, -1 ending the chain.
+   */
+  std::vector<int> fNodeCells;
+  int fNextNodeInCell[2 * wolf::Graph::vertexCapacity];
+  int fNodeCellColumns;
+  int fNodeCellRows;
+
+  unsigned int fNodeIndexRevision;
+  uint fNodeIndexWidth;
+  uint fNodeIndexHeight;
 
   /**
    * Object pool that holds the vertex widgets.
@@ -230,11 +292,15 @@ private:
 
   bool hovered;
 
-  float maxInput;
-  float maxInputAcceleration = 0.0f;
-
   float fInput;
 
+  static const int inputDensityBins = 64;
+  float fInputDensity[inputDensityBins];
+
+  FrameScheduler *fFrameScheduler;
+
+  StrokeBatch fGridBatch;
+
   ScopedPointer<MenuWidget> fRightClickMenu;
   GraphNode *fNodeSelectedByRightClick;
   wolf::CurveType fLastCurveTypeSelected;
@@ -253,6 +319,7 @@ public:
   void rebuildFromString(const char *serializedGraph);
   void reset();
   void updateInput(const float input);
+  void updateInputEnvelope(const EnvelopeCapture::Frame *frames, const int count);
 
   void setGraphGradientMode(GraphGradientMode graphGradientMode);
 
@@ -268,10 +335,17 @@ protected:
   void onResize(const ResizeEvent &ev) override;
   void onNanoDisplay() override;
 
+  /**
+   * Draw the parts of the graph which only change on resize: the margin, the background, the grid and the labels.
+   */
+  void drawStaticLayer();
+
 private:
   ScopedPointer<GraphWidgetInner> fGraphWidgetInner;
   Margin fMargin;
 
+  OffscreenLayer fStaticLayer;
+
   DISTRHO_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GraphWidget)
 };
 
@@ -23,26 +23,30 @@ public:
 	struct Item
 	{
 		const uint id;
-		const std::string name;
-		const std::string description;
+		// offsets of the name and the description in the label storage of the menu
+		const uint name_offset;
+		const uint description_offset;
 		bool enabled = true;
 		bool is_section = false;
+		// text metrics, measured when the layout is updated
+		float name_w_px = 0;
+		float description_w_px = 0;
 		Item(const int _id,
-			const std::string& _name,
-			const std::string& _description)
+			const uint _name_offset,
+			const uint _description_offset)
 			: id(_id),
-			  name(_name),
-			  description(_description),
+			  name_offset(_name_offset),
+			  description_offset(_description_offset),
 			  enabled(true),
 			  is_section(false)
 		{
 		}
 
 		// constructor for sections
-		Item(const std::string& _name)
+		Item(const uint _name_offset)
 			: id(-1),
-			  name(_name),
-			  description(""),
+			  name_offset(_name_offset),
+			  description_offset(0),
 			  enabled(true),
 			  is_section(true)
 		{
@@ -110,6 +114,16 @@ protected:
 private:
 	std::vector<Item> items;
 
+	// the names and descriptions of all items, each null-terminated.
+	// offset 0 is the empty string.
+	std::vector<char> labels;
+
+	// text metrics and item rectangles, only measured again when the items
+	// or the font sizes change
+	bool layout_dirty;
+	float line_h_px;
+	std::vector<DGL_NAMESPACE::Rectangle<float>> item_bounds;
+
 	// if the mouse moves outside these bounds, the menu will close.
 	// updated on show. assumes the bounds won't change while the menu is open.
 	// this is a safe assumption in most cases, because the user will have to
@@ -133,10 +147,13 @@ private:
 
 	Callback *callback;
 
-	void updateMaxItemWidth(const Item& item);
-	void adaptSize();
-	auto getItemWidthPx(const Item& item) -> float;
-	auto getItemBoundsPx(const int index) -> Rectangle<float>;
+	auto internLabel(const char *label) -> uint;
+	auto getLabel(const uint offset) const -> const char*;
+
+	void updateLayout();
+	void measureItem(Item& item);
+	auto getItemIndexAt(const Point<float>& pos) const -> int;
+	auto isItemEnabled(const int index) const -> bool;
 };
 
 END_NAMESPACE_DISTRHO
@@ -7,6 +7,7 @@
 #include "NanoMeter.hpp"
 #include "MixerSwitch.hpp"
 #include "MixerTrackName.hpp"
+#include "ResourceCache.hpp"
 
 START_NAMESPACE_DISTRHO
 
@@ -16,14 +17,15 @@ class MixerStrip : public NanoWidget
 {
 public:
     explicit MixerStrip(CarlaMixer* widget, Size<uint> size) noexcept;
-    NanoVG::Paint generateNoiseTexture();
+    ~MixerStrip();
 
 protected:
     void onNanoDisplay() override;
     void positionWidgets();
     
 private:
-    NanoVG::Paint fNoiseTexture;
+    ResourceCache *fResources;
+    const ResourceCache::Resource *fNoiseTexture;
 
     ScopedPointer<MixerSlider> fMixerSlider;
     ScopedPointer<NanoMeter> fMeter;
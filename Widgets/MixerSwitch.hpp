@@ -3,12 +3,12 @@
 
 #include "NanoSwitch.hpp"
 #include "Animation.hpp"
+#include "FrameScheduler.hpp"
 #include "Window.hpp"
 
 START_NAMESPACE_DISTRHO
 
-class MixerSwitch : public NanoSwitch,
-                    public IdleCallback
+class MixerSwitch : public NanoSwitch
 {
 public:
   enum MixerSwitchType
@@ -18,15 +18,17 @@ public:
   };
   
   explicit MixerSwitch(NanoWidget *widget, Size<uint> size) noexcept;
+  ~MixerSwitch();
 
   void setType(MixerSwitchType type);
 
 protected:
   void draw() override;
-  void idleCallback() override;
   void onStateChanged() override;
 
 private:
+  FrameScheduler *fFrameScheduler;
+
   Color fSocketColor;
   ColorTransition fSocketColorTransition;
 
@@ -3,6 +3,7 @@
 
 #include "Widget.hpp"
 #include "NanoVG.hpp"
+#include "ResourceCache.hpp"
 
 START_NAMESPACE_DISTRHO
 
@@ -10,6 +11,7 @@ class NanoMeter : public NanoWidget
 {
   public:
     explicit NanoMeter(NanoWidget *widget, Size<uint> size) noexcept;
+    ~NanoMeter();
 
     void setOutLeft(float value) noexcept;
     void setOutRight(float value) noexcept;
@@ -24,6 +26,9 @@ class NanoMeter : public NanoWidget
     Color fColor;
     bool fEnabled;
     float fOutLeft, fOutRight;
+
+    ResourceCache *fResources;
+    const ResourceCache::Resource *fPaints;
     DISTRHO_LEAK_DETECTOR(NanoMeter)
 };
 
@@ -4,6 +4,7 @@
 #include "WolfWidget.hpp"
 #include "SVGUtils.hpp"
 #include "DropShadow.hpp"
+#include "ResourceCache.hpp"
 
 START_NAMESPACE_DISTRHO
 
@@ -12,12 +13,16 @@ class SliderHandle : public HasDropShadow,
 {
 public:
   explicit SliderHandle(NanoWidget *widget, Size<uint> size) noexcept;
+  ~SliderHandle();
+
+  void setSvg(const char *path);
 
 protected:
   void onNanoDisplay() override;
 
 private:
-  struct NSVGimage *fImage;
+  ResourceCache *fResources;
+  const ResourceCache::Resource *fImage;
 
   DISTRHO_LEAK_DETECTOR(SliderHandle)
 };
@@ -43,6 +48,11 @@ public:
   void setCallback(Callback *callback) noexcept;
 
   void setHandleSize(const float width, const float height);
+
+  /**
+   * The SVG file the handle is drawn from. The handle draws nothing until it has one.
+   */
+  void setHandleSvg(const char *path);
   void setSocketMargin(const float top, const float bottom);
 
 protected:
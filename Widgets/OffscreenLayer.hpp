@@ -0,0 +1,62 @@
+#ifndef WOLF_OFFSCREEN_LAYER_HPP_INCLUDED
+#define WOLF_OFFSCREEN_LAYER_HPP_INCLUDED
+
+#include "Widget.hpp"
+#include "NanoVG.hpp"
+
+struct NVGLUframebuffer;
+
+START_NAMESPACE_DISTRHO
+
+/**
+ * A picture of the parts of a widget which rarely change, rendered once into an offscreen framebuffer
+ * and then drawn as a single image each frame.
+ *
+ * Usage, at the very start of onNanoDisplay(), before any other drawing or transform:
+ *   if (layer.beginRender()) { drawStaticParts(); layer.endRender(); }
+ *   layer.draw();
+ *
+ * When framebuffers aren't available, beginRender() returns true on every frame, so the parts get drawn directly.
+ * Only works for widgets drawn inside the frame of their parent, like the widgets of a plugin UI.
+ * Rendering the layer interrupts that frame, and only restores its transform: the parent must not leave a scissor
+ * or any other state set for the widget.
+ */
+class OffscreenLayer
+{
+public:
+  explicit OffscreenLayer(NanoWidget *widget);
+  ~OffscreenLayer();
+
+  /**
+   * Render the layer again at the next frame. The layer also gets rendered again when the size of the widget changes.
+   */
+  void invalidate();
+
+  bool beginRender();
+  void endRender();
+
+  void draw();
+
+private:
+  void restartParentFrame();
+
+  NanoWidget *fWidget;
+  NVGLUframebuffer *fFramebuffer;
+
+  uint fWidth;
+  uint fHeight;
+  float fScaling;
+
+  bool fDirty;
+  bool fRendering;
+  bool fIsSupported;
+
+  int fParentViewport[4];
+  float fParentTransform[6];
+
+  DISTRHO_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OffscreenLayer)
+};
+
+END_NAMESPACE_DISTRHO
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef WOLF_POPUP_OVERLAY_HPP_INCLUDED
+#define WOLF_POPUP_OVERLAY_HPP_INCLUDED
+
+#include "Widget.hpp"
+#include "Window.hpp"
+#include "NanoVG.hpp"
+
+#include <vector>
+
+START_NAMESPACE_DISTRHO
+
+/**
+ * A layer on top of all the widgets of a window, which hosts one popup at a time: menus, tooltips, value editors...
+ * There is one overlay per window, shared by all of its popups,
+ * so opening a popup only costs a repaint instead of a native window and its GL context.
+ * DGL draws the widgets of a window in the order they were created, and gives them events in the reverse order:
+ * the UI must create the overlay once it has created all of its other widgets, so that it stays on top of them.
+ */
+class PopupOverlay : public NanoWidget
+{
+public:
+  class Popup
+  {
+  public:
+    virtual ~Popup() {}
+
+    /**
+     * Measure the popup. Called when it opens, with the context it will be drawn with.
+     */
+    virtual Size<uint> getPopupSize(NanoVG &context) = 0;
+
+    /**
+     * Draw the popup, translated to its position.
+     */
+    virtual void onPopupDisplay(NanoVG &context) = 0;
+
+    /**
+     * Events over the popup, in its own coordinates.
+     */
+    virtual bool onPopupMouse(const Widget::MouseEvent &) { return true; }
+    virtual bool onPopupMotion(const Widget::MotionEvent &) { return true; }
+
+    /**
+     * Called when the popup gets closed, by itself or by a click outside of it.
+     */
+    virtual void onPopupClosed() {}
+  };
+
+  explicit PopupOverlay(Window &window);
+  ~PopupOverlay() override;
+
+  /**
+   * Get the overlay of the window of @a widget, or nullptr if the UI hasn't created it yet.
+   */
+  static PopupOverlay *get(Widget *widget);
+
+  /**
+   * Show @a popup at @a position, in the coordinates of the window, replacing the popup currently open.
+   * The popup is moved to fit in the window.
+   */
+  void open(Popup *popup, Point<int> position);
+
+  /**
+   * Close @a popup if it is the one currently open.
+   */
+  void close(Popup *popup);
+
+  bool isOpen(const Popup *popup) const;
+
+protected:
+  void onNanoDisplay() override;
+  bool onMouse(const MouseEvent &ev) override;
+  bool onMotion(const MotionEvent &ev) override;
+
+private:
+  bool popupContains(Point<int> pos) const;
+
+  Window &fWindow;
+
+  Popup *fPopup;
+  DGL_NAMESPACE::Rectangle<int> fPopupBounds;
+
+  DISTRHO_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PopupOverlay)
+};
+
+END_NAMESPACE_DISTRHO
+
+#endif
@@ -3,22 +3,24 @@
 
 #include "NanoSwitch.hpp"
 #include "Animation.hpp"
+#include "FrameScheduler.hpp"
 #include "Window.hpp"
 
 START_NAMESPACE_DISTRHO
 
-class RemoveDCSwitch : public NanoSwitch,
-                       public IdleCallback
+class RemoveDCSwitch : public NanoSwitch
 {
   public:
     explicit RemoveDCSwitch(NanoWidget *widget, Size<uint> size) noexcept;
+    ~RemoveDCSwitch();
 
   protected:
     void draw() override;
-    void idleCallback() override;
     void onStateChanged() override;
 
   private:
+    FrameScheduler *fFrameScheduler;
+
     Color fSocketColor;
     ColorTransition fSocketColorTransition;
 
@@ -0,0 +1,93 @@
+#ifndef WOLF_RESOURCE_CACHE_HPP_INCLUDED
+#define WOLF_RESOURCE_CACHE_HPP_INCLUDED
+
+#include "Widget.hpp"
+#include "NanoVG.hpp"
+
+#include <string>
+#include <vector>
+
+struct NSVGimage;
+
+START_NAMESPACE_DISTRHO
+
+/**
+ * Textures, parsed SVGs and paints shared by all the widgets drawing with the same NanoVG context.
+ * A resource is built by the first widget asking for it, with a given kind, size and parameters,
+ * and freed when the last widget using it releases it.
+ */
+class ResourceCache
+{
+public:
+  enum Kind
+  {
+    NoiseTexture = 0,
+    Svg,
+    Paints
+  };
+
+  static const int maxPaintCount = 4;
+
+  struct Resource
+  {
+    Kind kind;
+    Size<uint> size;
+    std::string params;
+
+    int refCount;
+
+    int image;
+    NSVGimage *svg;
+    NanoVG::Paint paints[maxPaintCount];
+  };
+
+  /**
+   * Fills the paints of a resource, with the size and the color it is keyed by.
+   */
+  typedef void (*PaintBuilder)(NVGcontext *context, Size<uint> size, Color color, NanoVG::Paint *paints);
+
+  /**
+   * Get the cache of the context of @a widget, creating it if needed.
+   * A widget which attaches must detach in its destructor, after releasing its resources.
+   */
+  static ResourceCache *attach(NanoWidget *widget);
+  static void detach(NanoWidget *widget);
+
+  /**
+   * A texture of subtle noise, as an image pattern in paints[0].
+   */
+  const Resource *acquireNoiseTexture(Size<uint> size);
+
+  /**
+   * An SVG file, parsed once. Returns nullptr if the file can't be parsed.
+   */
+  const Resource *acquireSvg(const char *path, const char *units, float dpi);
+
+  /**
+   * Paints which only depend on a size and a color, built by @a build.
+   * Widgets should use a distinct @a name for each builder.
+   */
+  const Resource *acquirePaints(const char *name, Size<uint> size, Color color, PaintBuilder build);
+
+  void release(const Resource *resource);
+
+private:
+  explicit ResourceCache(NVGcontext *context);
+  ~ResourceCache();
+
+  Resource *find(Kind kind, Size<uint> size, const std::string &params);
+  Resource *create(Kind kind, Size<uint> size, const std::string &params);
+
+  void destroy(Resource *resource);
+
+  NVGcontext *fContext;
+  int fWidgetCount;
+
+  std::vector<Resource *> fResources;
+
+  DISTRHO_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ResourceCache)
+};
+
+END_NAMESPACE_DISTRHO
+
+#endif
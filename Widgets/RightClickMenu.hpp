@@ -5,6 +5,7 @@
 #include "Window.hpp"
 #include "NanoVG.hpp"
 #include "NanoLabel.hpp"
+#include "PopupOverlay.hpp"
 
 #include <vector>
 
@@ -48,8 +49,11 @@ public:
   RightClickMenuSection(const char *label) noexcept;
 };
 
-class RightClickMenu : private Window,
-                       public NanoWidget
+/**
+ * A right click menu, shown as a popup in the overlay of the window of its parent.
+ * The menu can only be shown once the UI has created that overlay.
+ */
+class RightClickMenu : public PopupOverlay::Popup
 {
 public:
   class Callback
@@ -74,22 +78,24 @@ public:
   void setSectionEnabled(int index, bool enabled);
 
 protected:
-  void onNanoDisplay() override;
-  void onFocusOut() override;
-  bool onMouse(const MouseEvent &ev) override;
-  bool onMotion(const MotionEvent &ev) override;
-  void adaptSize();
-  void onClose() override;
+  Size<uint> getPopupSize(NanoVG &context) override;
+  void onPopupDisplay(NanoVG &context) override;
+  bool onPopupMouse(const Widget::MouseEvent &ev) override;
+  bool onPopupMotion(const Widget::MotionEvent &ev) override;
+  void onPopupClosed() override;
 
-  DGL_NAMESPACE::Rectangle<float> getBoundsOfItem(const int index);
-  DGL_NAMESPACE::Rectangle<float> getBoundsOfItemComment(const int index);
+  DGL_NAMESPACE::Rectangle<float> getBoundsOfItem(NanoVG &context, const int index);
+  DGL_NAMESPACE::Rectangle<float> getBoundsOfItemComment(NanoVG &context, const int index);
 
 private:
-  void findLongestItem();
+  void findLongestItem(NanoVG &context);
 
   std::vector<RightClickMenuItem> fItems;
   NanoWidget *fParent;
 
+  Size<uint> fSize;
+  std::vector<DGL_NAMESPACE::Rectangle<float>> fItemBounds;
+
   float fFontSize;
   float fSectionFontSize;
 
@@ -99,6 +105,8 @@ private:
   Margin fMargin;
 
   Callback *fCallback;
+
+  DISTRHO_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RightClickMenu)
 };
 
 #endif
@@ -0,0 +1,51 @@
+#ifndef WOLF_STROKE_BATCH_HPP_INCLUDED
+#define WOLF_STROKE_BATCH_HPP_INCLUDED
+
+#include "Color.hpp"
+#include "NanoVG.hpp"
+
+#include <vector>
+
+START_NAMESPACE_DISTRHO
+
+/**
+ * Collects line segments and strokes all the segments which share a style as a single path,
+ * instead of one path and one state change per segment.
+ * Styles are stroked in the order they were first used. Keep the batch around to reuse its memory.
+ */
+class StrokeBatch
+{
+public:
+  StrokeBatch();
+
+  void addLine(const Color &color, float width, float x1, float y1, float x2, float y2);
+
+  /**
+   * Stroke everything that was added, then empty the batch.
+   */
+  void submit(NanoVG &nanovg);
+
+private:
+  struct Style
+  {
+    Color color;
+    float width;
+  };
+
+  struct Segment
+  {
+    int style;
+    float x1, y1, x2, y2;
+  };
+
+  int getStyleIndex(const Color &color, float width);
+
+  std::vector<Style> fStyles;
+  std::vector<Segment> fSegments;
+
+  DISTRHO_LEAK_DETECTOR(StrokeBatch)
+};
+
+END_NAMESPACE_DISTRHO
+
+#endif
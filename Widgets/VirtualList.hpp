@@ -0,0 +1,102 @@
+#ifndef WOLF_VIRTUAL_LIST_HPP_INCLUDED
+#define WOLF_VIRTUAL_LIST_HPP_INCLUDED
+
+#include "Widget.hpp"
+#include "NanoVG.hpp"
+#include "FrameScheduler.hpp"
+
+#include <vector>
+
+START_NAMESPACE_DISTRHO
+
+/**
+ * A scrollable list of items of the same extent, which only has widgets for the items in view.
+ * Widgets scrolled out are hidden and kept to show the items scrolled in,
+ * so a list of thousands of items costs about as much as the few that fit in it.
+ * Only the items entirely in view are shown, since the widgets would otherwise draw outside of the list.
+ */
+class VirtualList : public NanoWidget
+{
+public:
+  enum Orientation
+  {
+    Vertical,
+    Horizontal
+  };
+
+  class Delegate
+  {
+  public:
+    virtual ~Delegate() {}
+
+    /**
+     * Create a widget able to show any item, as a subwidget of @a list.
+     * The list owns it, and deletes it with itself.
+     */
+    virtual NanoWidget *createItemWidget(VirtualList *list) = 0;
+
+    /**
+     * Make @a widget show the item at @a index. The list positions and sizes it.
+     */
+    virtual void bindItemWidget(NanoWidget *widget, int index) = 0;
+  };
+
+  explicit VirtualList(NanoWidget *widget, Size<uint> size, Delegate *delegate, Orientation orientation = Vertical) noexcept;
+  ~VirtualList();
+
+  void setItemCount(int count);
+  int getItemCount();
+
+  /**
+   * The height of the items of a vertical list, or the width of the items of a horizontal one.
+   */
+  void setItemExtent(uint extent);
+  uint getItemExtent();
+
+  void setScrollOffset(float offset);
+  float getScrollOffset();
+  float getMaxScrollOffset();
+
+  void scrollToItem(int index);
+
+  /**
+   * Bind the widgets in view again, after the items they show changed.
+   */
+  void refreshItems();
+
+protected:
+  void onNanoDisplay() override;
+
+  bool onScroll(const ScrollEvent &ev) override;
+  void onResize(const ResizeEvent &ev) override;
+  void onPositionChanged(const PositionChangedEvent &ev) override;
+
+private:
+  struct BoundWidget
+  {
+    NanoWidget *widget;
+    int index;
+  };
+
+  void updateVisibleItems();
+  void positionItemWidget(NanoWidget *widget, int index);
+
+  uint getViewExtent();
+
+  Delegate *fDelegate;
+  Orientation fOrientation;
+  FrameScheduler *fFrameScheduler;
+
+  int fItemCount;
+  uint fItemExtent;
+  float fScrollOffset;
+
+  std::vector<BoundWidget> fBoundWidgets;
+  std::vector<NanoWidget *> fRecycledWidgets;
+
+  DISTRHO_LEAK_DETECTOR(VirtualList)
+};
+
+END_NAMESPACE_DISTRHO
+
+#endif
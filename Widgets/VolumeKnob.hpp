@@ -3,19 +3,18 @@
 
 #include "NanoKnob.hpp"
 #include "Animation.hpp"
+#include "FrameScheduler.hpp"
 
 START_NAMESPACE_DISTRHO
 
-class VolumeKnob : public NanoKnob,
-                   public IdleCallback
+class VolumeKnob : public NanoKnob
 {
 public:
   /* explicit VolumeKnob(Window &parent, Size<uint> size) noexcept; */
   explicit VolumeKnob(NanoWidget *widget, Size<uint> size) noexcept;
+  ~VolumeKnob();
 
 protected:
-  void idleCallback() override;
-
   void onMouseHover() override;
   void onMouseLeave() override;
   void onMouseUp() override;
@@ -24,6 +23,8 @@ protected:
   void draw() override;
 
 private:
+  FrameScheduler *fFrameScheduler;
+
   ScopedPointer<FloatTransition> fGrowAnimation;
   ScopedPointer<ColorTransition> fHoverAnimation;
   
@@ -1,13 +1,30 @@
 
 #include "DropShadow.hpp"
+#include "nanovg.h"
 
 START_NAMESPACE_DISTRHO
 
-DropShadow::DropShadow(NanoWidget *widget, Size<uint> size) noexcept : WolfWidget(widget)
+static void buildDropShadowPaints(NVGcontext *context, Size<uint> size, Color color, NanoVG::Paint *paints)
+{
+    const float halfWidth = size.getWidth() / 2.0f;
+    const float halfHeight = size.getHeight() / 2.0f;
+
+    paints[0] = nvgRadialGradient(context, halfWidth, halfHeight, 2.f, 13.0f, color, Color(14, 14, 14, 0));
+}
+
+DropShadow::DropShadow(NanoWidget *widget, Size<uint> size) noexcept : WolfWidget(widget),
+                                                                       fResources(ResourceCache::attach(this)),
+                                                                       fGradient(nullptr)
 {
     setSize(size);
 }
 
+DropShadow::~DropShadow()
+{
+    fResources->release(fGradient);
+    ResourceCache::detach(this);
+}
+
 HasDropShadow::HasDropShadow(NanoWidget *widget, Size<uint> size) noexcept : fDropShadow(widget, size)
 {
 }
@@ -20,10 +37,16 @@ void DropShadow::onNanoDisplay()
     const float halfWidth = width / 2.0f;
     const float halfHeight = height / 2.0f;
 
+    //every shadow of the same size uses the same gradient
+    if (fGradient == nullptr || fGradient->size != getSize())
+    {
+        fResources->release(fGradient);
+        fGradient = fResources->acquirePaints("DropShadow", getSize(), Color(14, 14, 14, 155), buildDropShadowPaints);
+    }
+
     beginPath();
 
-    Paint gradient = radialGradient(halfWidth, halfHeight, 2.f, 13.0f, Color(14, 14, 14, 155), Color(14, 14, 14, 0));
-    fillPaint(gradient);
+    fillPaint(fGradient->paints[0]);
 
     ellipse(halfWidth, halfHeight, halfWidth, halfHeight);
 
@@ -0,0 +1,72 @@
+#include "FontRegistry.hpp"
+
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+START_NAMESPACE_DISTRHO
+
+struct EmbeddedFont
+{
+    const char *name;
+    const char *data;
+    uint size;
+};
+
+static std::vector<EmbeddedFont> &getFonts()
+{
+    static std::vector<EmbeddedFont> fonts;
+
+    return fonts;
+}
+
+//widgets of different plugin instances may be created on different threads
+static std::mutex fontsMutex;
+
+void FontRegistry::add(const char *name, const char *data, uint size)
+{
+    std::lock_guard<std::mutex> lock(fontsMutex);
+
+    std::vector<EmbeddedFont> &fonts = getFonts();
+
+    for (size_t i = 0; i < fonts.size(); ++i)
+    {
+        if (std::strcmp(fonts[i].name, name) == 0)
+            return;
+    }
+
+    const EmbeddedFont font = {name, data, size};
+
+    fonts.push_back(font);
+}
+
+NanoVG::FontId FontRegistry::load(NanoVG &context, const char *name)
+{
+    //contexts come and go with their windows, so the loaded fonts are looked up in the context itself
+    const NanoVG::FontId loadedId = context.findFont(name);
+
+    if (loadedId != -1)
+        return loadedId;
+
+    EmbeddedFont font = {nullptr, nullptr, 0};
+
+    {
+        std::lock_guard<std::mutex> lock(fontsMutex);
+
+        const std::vector<EmbeddedFont> &fonts = getFonts();
+
+        for (size_t i = 0; i < fonts.size(); ++i)
+        {
+            if (std::strcmp(fonts[i].name, name) == 0)
+                font = fonts[i];
+        }
+    }
+
+    if (font.data == nullptr)
+        return -1;
+
+    //parsed outside of the lock, the data of an embedded font never changes
+    return context.createFontFromMemory(name, (const uchar *)font.data, font.size, false);
+}
+
+END_NAMESPACE_DISTRHO
@@ -0,0 +1,198 @@
+#include "FrameScheduler.hpp"
+
+#include <mutex>
+
+START_NAMESPACE_DISTRHO
+
+//one scheduler per window, shared by all its widgets
+//the windows of different plugin instances may live on different threads, so the list is locked
+static std::vector<FrameScheduler *> schedulers;
+static std::mutex schedulersMutex;
+
+FrameScheduler::FrameScheduler(Window &window) : fWindow(window),
+                                                 fWidgetCount(0),
+                                                 fAnimationEngine(std::make_shared<AnimationEngine>()),
+                                                 fFrameDuration(),
+                                                 fLastFrameTime(std::chrono::steady_clock::now())
+{
+    setFrameRate(60.0f);
+
+    fWindow.addIdleCallback(this);
+}
+
+FrameScheduler::~FrameScheduler()
+{
+    fWindow.removeIdleCallback(this);
+}
+
+FrameScheduler *FrameScheduler::attach(Widget *widget)
+{
+    Window &window = widget->getParentWindow();
+
+    std::lock_guard<std::mutex> lock(schedulersMutex);
+
+    FrameScheduler *scheduler = nullptr;
+
+    for (size_t i = 0; i < schedulers.size(); ++i)
+    {
+        if (&schedulers[i]->fWindow == &window)
+            scheduler = schedulers[i];
+    }
+
+    if (scheduler == nullptr)
+    {
+        scheduler = new FrameScheduler(window);
+        schedulers.push_back(scheduler);
+    }
+
+    ++scheduler->fWidgetCount;
+
+    return scheduler;
+}
+
+void FrameScheduler::detach(Widget *widget)
+{
+    Window &window = widget->getParentWindow();
+
+    std::lock_guard<std::mutex> lock(schedulersMutex);
+
+    for (size_t i = 0; i < schedulers.size(); ++i)
+    {
+        FrameScheduler *scheduler = schedulers[i];
+
+        if (&scheduler->fWindow != &window)
+            continue;
+
+        scheduler->forgetWidget(widget);
+
+        if (--scheduler->fWidgetCount == 0)
+        {
+            schedulers.erase(schedulers.begin() + i);
+            delete scheduler;
+        }
+
+        return;
+    }
+}
+
+void FrameScheduler::forgetWidget(Widget *widget)
+{
+    for (size_t i = fDirtyWidgets.size(); i-- > 0;)
+    {
+        if (fDirtyWidgets[i].widget == widget)
+            fDirtyWidgets.erase(fDirtyWidgets.begin() + i);
+    }
+
+    for (size_t i = fRepaintedWidgets.size(); i-- > 0;)
+    {
+        if (fRepaintedWidgets[i].widget == widget)
+            fRepaintedWidgets.erase(fRepaintedWidgets.begin() + i);
+    }
+
+    for (size_t i = fAnimations.size(); i-- > 0;)
+    {
+        if (fAnimations[i].widget == widget)
+            fAnimations.erase(fAnimations.begin() + i);
+    }
+}
+
+void FrameScheduler::markDirty(Widget *widget, DirtyReason reason)
+{
+    for (size_t i = 0; i < fDirtyWidgets.size(); ++i)
+    {
+        DirtyWidget &dirtyWidget = fDirtyWidgets[i];
+
+        if (dirtyWidget.widget == widget)
+        {
+            dirtyWidget.reasons |= reason;
+
+            return;
+        }
+    }
+
+    DirtyWidget dirtyWidget;
+    dirtyWidget.widget = widget;
+    dirtyWidget.reasons = reason;
+
+    fDirtyWidgets.push_back(dirtyWidget);
+}
+
+AnimationEngine &FrameScheduler::getAnimationEngine()
+{
+    return *fAnimationEngine;
+}
+
+void FrameScheduler::runAnimation(Animation *animation, Widget *widget)
+{
+    for (size_t i = 0; i < fAnimations.size(); ++i)
+    {
+        if (fAnimations[i].animation == animation)
+            return;
+    }
+
+    RunningAnimation runningAnimation;
+    runningAnimation.animation = animation;
+    runningAnimation.widget = widget;
+
+    fAnimations.push_back(runningAnimation);
+}
+
+int FrameScheduler::getRepaintReasons(Widget *widget) const
+{
+    for (size_t i = 0; i < fRepaintedWidgets.size(); ++i)
+    {
+        if (fRepaintedWidgets[i].widget == widget)
+            return fRepaintedWidgets[i].reasons;
+    }
+
+    return 0;
+}
+
+void FrameScheduler::setFrameRate(float framesPerSecond)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(framesPerSecond > 0.0f, );
+
+    fFrameDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(1.0f / framesPerSecond));
+}
+
+void FrameScheduler::idleCallback()
+{
+    //nothing to do: the common case, which must stay cheap
+    if (fDirtyWidgets.empty() && fAnimations.empty())
+        return;
+
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    //coalesce everything that happens between two frames
+    if (now - fLastFrameTime < fFrameDuration)
+        return;
+
+    fLastFrameTime = now;
+
+    //every animation of the window steps from this one clock sample
+    if (!fAnimations.empty())
+        fAnimationEngine->advance(now);
+
+    for (size_t i = 0; i < fAnimations.size();)
+    {
+        RunningAnimation &runningAnimation = fAnimations[i];
+
+        markDirty(runningAnimation.widget, AnimationStep);
+
+        //the last step has been applied, so the animation can go
+        if (!runningAnimation.animation->isPlaying())
+            fAnimations.erase(fAnimations.begin() + i);
+        else
+            ++i;
+    }
+
+    fRepaintedWidgets.swap(fDirtyWidgets);
+    fDirtyWidgets.clear();
+
+    for (size_t i = 0; i < fRepaintedWidgets.size(); ++i)
+    {
+        fRepaintedWidgets[i].widget->repaint();
+    }
+}
+
+END_NAMESPACE_DISTRHO
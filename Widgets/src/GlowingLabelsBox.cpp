@@ -1,6 +1,8 @@
 #include "GlowingLabelsBox.hpp"
 #include "Mathf.hpp"
 
+#include <cmath>
+
 START_NAMESPACE_DISTRHO
 
 GlowingLabelsBox::GlowingLabelsBox(NanoWidget *widget, Size<uint> size) noexcept : LabelContainer(widget, size)
@@ -30,8 +32,10 @@ void GlowingLabelsBox::onNanoDisplay()
     const float labelMarginTop = 4.0f;
     const float labelVerticalSpacing = labelSize + 7.0f;
 
-    //Text
-    for (int i = 0; i < getLabelCount(); ++i)
+    //Text, up to the last label which shows in the box
+    const int visibleLabelCount = std::min(getLabelCount(), (int)std::ceil((height - labelMarginTop) / labelVerticalSpacing));
+
+    for (int i = 0; i < visibleLabelCount; ++i)
     {
         beginPath();
 
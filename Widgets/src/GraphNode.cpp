@@ -141,10 +141,9 @@ int GraphNode::getAbsoluteY() const
 
 float GraphTensionHandle::getX() const
 {
-    GraphVertex *leftVertex = vertex;
-    GraphVertex *rightVertex = leftVertex->getVertexAtRight();
+    parent->updateNodeIndex();
 
-    return (leftVertex->getX() + rightVertex->getX()) / 2.0f;
+    return position.getX();
 }
 
 wolf::Graph *GraphNode::getLineEditor() const
@@ -158,10 +157,20 @@ float GraphVertex::getTension()
 }
 
 float GraphTensionHandle::getY() const
+{
+    parent->updateNodeIndex();
+
+    return position.getY();
+}
+
+void GraphTensionHandle::updatePosition()
 {
     GraphVertex *leftVertex = vertex;
     GraphVertex *rightVertex = leftVertex->getVertexAtRight();
 
+    if (rightVertex == nullptr) //last vertex doesn't have a tension handle
+        return;
+
     float tension = vertex->getTension();
 
     //calculate value for generic curve
@@ -174,7 +183,8 @@ float GraphTensionHandle::getY() const
 
     wolf::CurveType curveType = getLineEditor()->getVertexAtIndex(index)->getType();
 
-    return wolf::Graph::getOutValue(0.5f, tension, p1x, p1y, p2x, p2y, curveType) * parent->getHeight();
+    position.setX((leftVertex->getX() + rightVertex->getX()) / 2.0f);
+    position.setY(wolf::Graph::getOutValue(0.5f, tension, p1x, p1y, p2x, p2y, curveType) * parent->getHeight());
 }
 
 GraphVertex *GraphVertex::getVertexAtLeft() const
@@ -253,7 +263,7 @@ bool GraphVertex::onMotion(const Widget::MotionEvent &ev)
 
     updateGraph();
 
-    parent->repaint();
+    parent->fFrameScheduler->markDirty(parent, FrameScheduler::StateChanged);
 
     //Cancel out double clicks
     lastClickButton = 0;
@@ -320,7 +330,7 @@ bool GraphTensionHandle::onMotion(const Widget::MotionEvent &ev)
 
     parent->ui->setState("graph", lineEditor->serialize());
 
-    parent->repaint();
+    parent->fFrameScheduler->markDirty(parent, FrameScheduler::StateChanged);
 
     return true;
 }
@@ -391,7 +401,7 @@ bool GraphVertex::onMouse(const Widget::MouseEvent &ev)
         window.setCursorStyle(Window::CursorStyle::Grab);
     }
 
-    parent->repaint();
+    parent->fFrameScheduler->markDirty(parent, FrameScheduler::StateChanged);
 
     return true;
 }
@@ -422,7 +432,7 @@ bool GraphTensionHandle::onMouse(const Widget::MouseEvent &ev)
         window.setCursorStyle(Window::CursorStyle::Grab);
     }
 
-    parent->repaint();
+    parent->fFrameScheduler->markDirty(parent, FrameScheduler::StateChanged);
 
     return true;
 }
@@ -7,9 +7,11 @@
 #include "GraphNode.hpp"
 #include "Mathf.hpp"
 #include "Config.hpp"
+#include "FontRegistry.hpp"
 
 #include "Fonts/chivo_italic.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <cmath>
@@ -19,7 +21,8 @@ START_NAMESPACE_DISTRHO
 const char *graphDefaultState = "0x0p+0,0x0p+0,0x0p+0,0;0x1p+0,0x1p+0,0x0p+0,0;";
 
 GraphWidget::GraphWidget(UI *ui, Size<uint> size) : NanoWidget((NanoWidget *)ui),
-                                                    fMargin(16, 16, 16, 16)
+                                                    fMargin(16, 16, 16, 16),
+                                                    fStaticLayer(this)
 {
     setSize(size);
 
@@ -36,7 +39,7 @@ GraphWidget::~GraphWidget()
 {
 }
 
-void GraphWidget::onNanoDisplay()
+void GraphWidget::drawStaticLayer()
 {
     const float width = getWidth();
     const float height = getHeight();
@@ -68,19 +71,37 @@ void GraphWidget::onNanoDisplay()
 
     closePath();
 
+    save();
+
     translate(fMargin.left, fMargin.top);
-    fGraphWidgetInner->setAbsolutePos(getAbsoluteX() + fMargin.left, getAbsoluteY() + fMargin.top);
 
     fGraphWidgetInner->drawBackground();
     fGraphWidgetInner->drawGrid();
     fGraphWidgetInner->drawInOutLabels();
 
+    restore();
+}
+
+void GraphWidget::onNanoDisplay()
+{
+    if (fStaticLayer.beginRender())
+    {
+        drawStaticLayer();
+        fStaticLayer.endRender();
+    }
+
+    fStaticLayer.draw();
+
+    translate(fMargin.left, fMargin.top);
+    fGraphWidgetInner->setAbsolutePos(getAbsoluteX() + fMargin.left, getAbsoluteY() + fMargin.top);
+
     fGraphWidgetInner->flipYAxis();
 
     if (fGraphWidgetInner->focusedElement != nullptr && dynamic_cast<GraphVertex *>(fGraphWidgetInner->focusedElement))
         fGraphWidgetInner->drawAlignmentLines();
 
     fGraphWidgetInner->drawGradient();
+    fGraphWidgetInner->drawInputDensity();
     fGraphWidgetInner->drawGraphLine(CONFIG_NAMESPACE::graph_edges_stroke_width, CONFIG_NAMESPACE::graph_edges_foreground_normal, CONFIG_NAMESPACE::graph_edges_foreground_focused); //inner
 
     fGraphWidgetInner->drawInputIndicator();
@@ -100,6 +121,8 @@ void GraphWidget::onResize(const ResizeEvent &ev)
     const Size<uint> graphInnerSize = Size<uint>(graphInnerWidth, graphInnerHeight);
 
     fGraphWidgetInner->setSize(graphInnerSize);
+
+    fStaticLayer.invalidate();
 }
 
 void GraphWidget::rebuildFromString(const char *serializedGraph)
@@ -117,6 +140,11 @@ void GraphWidget::updateInput(const float input)
     fGraphWidgetInner->updateInput(input);
 }
 
+void GraphWidget::updateInputEnvelope(const EnvelopeCapture::Frame *frames, const int count)
+{
+    fGraphWidgetInner->updateInputEnvelope(frames, count);
+}
+
 void GraphWidget::setGraphGradientMode(GraphGradientMode graphGradientMode)
 {
     fGraphWidgetInner->setGraphGradientMode(graphGradientMode);
@@ -150,22 +178,33 @@ void GraphWidget::setMustHideVertices(const bool hide)
 GraphWidgetInner::GraphWidgetInner(UI *ui, Size<uint> size)
     : NanoWidget((NanoWidget *)ui),
       ui(ui),
-      graphVerticesPool(wolf::maxVertices, this, GraphVertexType::Middle),
+      fCurvePeak(0.0f),
+      fCurveRevision(0),
+      fCurveWidth(0),
+      fCurveHeight(0),
+      fNodeCellColumns(0),
+      fNodeCellRows(0),
+      fNodeIndexRevision(0),
+      fNodeIndexWidth(0),
+      fNodeIndexHeight(0),
+      graphVerticesPool(wolf::Graph::vertexCapacity, this, GraphVertexType::Middle),
       focusedElement(nullptr),
       mouseLeftDown(false),
       mouseRightDown(false),
       graphGradientMode(GraphGradientMode::None),
       mustHideVertices(false),
       hovered(false),
-      maxInput(0.0f),
       fInput(0.0f),
       fLastCurveTypeSelected(wolf::SingleCurve)
 {
+    //attached first, since laying the vertices out marks the widget dirty
+    fFrameScheduler = FrameScheduler::attach(this);
+
     setSize(size);
 
-    initializeDefaultVertices();
+    std::fill(fInputDensity, fInputDensity + inputDensityBins, 0.0f);
 
-    getParentWindow().addIdleCallback(this);
+    initializeDefaultVertices();
 
     fRightClickMenu = new MenuWidget(this);
 
@@ -181,15 +220,13 @@ GraphWidgetInner::GraphWidgetInner(UI *ui, Size<uint> size)
     fRightClickMenu->setCallback(this);
 
     using namespace WOLF_FONTS;
-    createFontFromMemory("chivo_italic", (const uchar *)chivo_italic, chivo_italic_size, 0);
+    FontRegistry::add("chivo_italic", chivo_italic, chivo_italic_size);
+    FontRegistry::load(*this, "chivo_italic");
 }
 
 GraphWidgetInner::~GraphWidgetInner()
 {
-    for (int i = 0; i < lineEditor.getVertexCount(); ++i)
-    {
-        delete graphVertices[i];
-    }
+    FrameScheduler::detach(this);
 }
 
 void GraphWidgetInner::onResize(const ResizeEvent &ev)
@@ -210,7 +247,9 @@ void GraphWidgetInner::positionGraphNodes()
         vertexWidget->setPos(logicalVertex->getX() * getWidth(), logicalVertex->getY() * getHeight());
     }
 
-    repaint();
+    rebuildNodeIndex();
+
+    fFrameScheduler->markDirty(this, FrameScheduler::StateChanged);
 }
 
 void GraphWidgetInner::initializeDefaultVertices()
@@ -310,85 +349,39 @@ void GraphWidgetInner::drawGrid()
     const Color gridMiddleLineHorizontalColor = CONFIG_NAMESPACE::grid_middle_line_horizontal;
     const Color gridMiddleLineVerticalColor = CONFIG_NAMESPACE::grid_middle_line_vertical;
 
+    //the lines are batched by color, so that each color is stroked once:
+    //subgrid first, then background, then foreground
+
     //vertical
     for (int i = 0; i < squaresPerRow + 1; ++i)
     {
         const float posX = std::round(i * verticalStep);
+        const float subGridX = std::round(posX + verticalStep / 2.0f);
 
-        //subgrid
-        beginPath();
-        strokeWidth(lineWidth);
-        strokeColor(subGridColor);
-
-        moveTo(std::round(posX + verticalStep / 2.0f), 0.0f);
-        lineTo(std::round(posX + verticalStep / 2.0f), height);
-
-        stroke();
-        closePath();
-
-        //background
-        beginPath();
-        strokeWidth(lineWidth);
-        strokeColor(gridBackgroundColor);
-
-        moveTo(posX + lineWidth, 0.0f);
-        lineTo(posX + lineWidth, height);
-
-        stroke();
-        closePath();
-
-        //foreground
-        beginPath();
-        strokeWidth(lineWidth);
-        strokeColor(i == gridMiddleLineIndex ? gridMiddleLineVerticalColor : gridForegroundColor);
-
-        moveTo(posX, 0.0f);
-        lineTo(posX, height);
-
-        stroke();
-        closePath();
+        fGridBatch.addLine(subGridColor, lineWidth, subGridX, 0.0f, subGridX, height);
+        fGridBatch.addLine(gridBackgroundColor, lineWidth, posX + lineWidth, 0.0f, posX + lineWidth, height);
     }
 
     //horizontal
     for (int i = 0; i < squaresPerRow + 1; ++i)
     {
         const float posY = std::round(i * horizontalStep);
+        const float subGridY = std::round(posY + horizontalStep / 2.0f);
 
-        //subgrid
-        beginPath();
-        strokeWidth(lineWidth);
-        strokeColor(subGridColor);
-
-        moveTo(0.0f, std::round(posY + horizontalStep / 2.0f));
-        lineTo(width, std::round(posY + horizontalStep / 2.0f));
-
-        stroke();
-        closePath();
-
-        //background
-        beginPath();
-        strokeWidth(lineWidth);
-
-        moveTo(0.0f, posY + lineWidth);
-        lineTo(width, posY + lineWidth);
-
-        strokeColor(gridBackgroundColor);
-
-        stroke();
-        closePath();
-
-        //foreground
-        beginPath();
-        strokeWidth(lineWidth);
-
-        moveTo(0.0f, posY);
-        lineTo(width, posY);
+        fGridBatch.addLine(subGridColor, lineWidth, 0.0f, subGridY, width, subGridY);
+        fGridBatch.addLine(gridBackgroundColor, lineWidth, 0.0f, posY + lineWidth, width, posY + lineWidth);
+    }
 
-        strokeColor(i == gridMiddleLineIndex ? gridMiddleLineHorizontalColor : gridForegroundColor);
+    for (int i = 0; i < squaresPerRow + 1; ++i)
+    {
+        const float posX = std::round(i * verticalStep);
+        const float posY = std::round(i * horizontalStep);
 
-        stroke();
-        closePath();
+        fGridBatch.addLine(i == gridMiddleLineIndex ? gridMiddleLineVerticalColor : gridForegroundColor, lineWidth, posX, 0.0f, posX, height);
+        fGridBatch.addLine(i == gridMiddleLineIndex ? gridMiddleLineHorizontalColor : gridForegroundColor, lineWidth, 0.0f, posY, width, posY);
     }
+
+    fGridBatch.submit(*this);
 }
 
 void GraphWidgetInner::drawBackground()
@@ -429,15 +422,172 @@ bool GraphWidgetInner::edgeMustBeEmphasized(int vertexIndex)
     return focusedElement == vertex || focusedElement == vertex->getVertexAtRight();*/
 }
 
+//max distance in pixels between the sampled curve and the actual one
+static const float curveTolerance = 0.25f;
+static const int maxCurveSubdivisions = 12;
+
+//the longest span sampled before checking the curvature
+static const float maxInitialPiecePixels = 64.0f;
+
+//a period of a wave needs about as many points at any width, so shorter ones are cheaper to sample at every pixel
+static const float minWavePeriodPixels = 64.0f;
+
+/**
+ * An edge of the graph, evaluated in pixels.
+ */
+struct CurveEdge
+{
+    CurveEdge(wolf::Vertex *leftVertex, wolf::Vertex *rightVertex, float width, float height) : p1x(leftVertex->getX()),
+                                                                                              p1y(leftVertex->getY()),
+                                                                                              p2x(rightVertex->getX()),
+                                                                                              p2y(rightVertex->getY()),
+                                                                                              tension(leftVertex->getTension()),
+                                                                                              type(leftVertex->getType()),
+                                                                                              width(width),
+                                                                                              height(height)
+    {
+    }
+
+    float getHeightAt(float x) const
+    {
+        return wolf::Graph::getOutValue(x / width, tension, p1x, p1y, p2x, p2y, type) * height;
+    }
+
+    const float p1x, p1y;
+    const float p2x, p2y;
+    const float tension;
+    const wolf::CurveType type;
+    const float width, height;
+};
+
+/**
+ * Append the points of the curve between (x1, y1), excluded, and (x2, y2), splitting the span
+ * in two for as long as the curve strays from the straight line between its ends.
+ */
+static void subdivideCurve(const CurveEdge &edge, float x1, float y1, float x2, float y2, int depth, std::vector<Point<float>> &points)
+{
+    const float middleX = (x1 + x2) / 2.0f;
+    const float middleY = edge.getHeightAt(middleX);
+
+    if (depth < maxCurveSubdivisions && x2 - x1 > 1.0f && std::abs(middleY - (y1 + y2) / 2.0f) > curveTolerance)
+    {
+        subdivideCurve(edge, x1, y1, middleX, middleY, depth + 1, points);
+        subdivideCurve(edge, middleX, middleY, x2, y2, depth + 1, points);
+    }
+    else
+    {
+        points.push_back(Point<float>(x2, y2));
+    }
+}
+
+void GraphWidgetInner::updateCurvePoints()
+{
+    const uint width = getWidth();
+    const uint height = getHeight();
+
+    //the revision of the graph changes with every edit, including warp changes
+    if (!fCurvePoints.empty() && fCurveRevision == lineEditor.getRevision() && fCurveWidth == width && fCurveHeight == height)
+        return;
+
+    fCurvePoints.clear();
+    fCurvePeak = 0.0f;
+
+    const int vertexCount = lineEditor.getVertexCount();
+
+    for (int vertexIndex = 0; vertexIndex < vertexCount - 1; ++vertexIndex)
+    {
+        wolf::Vertex *leftVertex = lineEditor.getVertexAtIndex(vertexIndex);
+        wolf::Vertex *rightVertex = lineEditor.getVertexAtIndex(vertexIndex + 1);
+
+        fEdgeStarts[vertexIndex] = fCurvePoints.size();
+
+        const CurveEdge edge(leftVertex, rightVertex, width, height);
+
+        fCurvePoints.push_back(Point<float>(edge.p1x * width, edge.p1y * height));
+
+        const float edgeLength = (edge.p2x - edge.p1x) * width;
+        const float detail = wolf::Graph::getCurveDetail(edge.tension, edge.type);
+
+        const bool hasSteps = edge.type == wolf::StairsCurve && detail > 1;
+        const bool isHighFrequencyWave = edge.type == wolf::WaveCurve && edgeLength < detail * minWavePeriodPixels;
+
+        if (hasSteps || isHighFrequencyWave)
+        {
+            //discontinuities and fast oscillations: one point per pixel
+            for (int i = 0; i <= edgeLength; ++i)
+            {
+                const float x = edge.p1x * width + i;
+
+                fCurvePoints.push_back(Point<float>(x, edge.getHeightAt(x)));
+            }
+
+            fCurvePoints.push_back(Point<float>(edge.p2x * width, edge.p2y * height));
+        }
+        else
+        {
+            //a few pieces per feature of the curve, so that the subdivision doesn't miss any bump
+            const int pieceCount = std::max(std::ceil(detail * 4), std::ceil(edgeLength / maxInitialPiecePixels));
+
+            //the last piece ends exactly on the right vertex
+
+            float x1 = edge.p1x * width;
+            float y1 = edge.p1y * height;
+
+            for (int i = 1; i <= pieceCount; ++i)
+            {
+                const float x2 = i == pieceCount ? edge.p2x * width : x1 + edgeLength / pieceCount;
+                const float y2 = i == pieceCount ? edge.p2y * height : edge.getHeightAt(x2);
+
+                subdivideCurve(edge, x1, y1, x2, y2, 0, fCurvePoints);
+
+                x1 = x2;
+                y1 = y2;
+            }
+        }
+    }
+
+    fEdgeStarts[std::max(vertexCount - 1, 0)] = fCurvePoints.size();
+
+    for (const Point<float> &point : fCurvePoints)
+        fCurvePeak = std::max(fCurvePeak, point.getY());
+
+    fCurveRevision = lineEditor.getRevision();
+    fCurveWidth = width;
+    fCurveHeight = height;
+}
+
+static bool isLeftOf(const Point<float> &point, const float x)
+{
+    return point.getX() < x;
+}
+
+float GraphWidgetInner::getCurveHeightAt(const float x) const
+{
+    DISTRHO_SAFE_ASSERT_RETURN(!fCurvePoints.empty(), 0.0f);
+
+    const std::vector<Point<float>>::const_iterator right = std::lower_bound(fCurvePoints.begin(), fCurvePoints.end(), x, isLeftOf);
+
+    if (right == fCurvePoints.begin())
+        return right->getY();
+
+    if (right == fCurvePoints.end())
+        return fCurvePoints.back().getY();
+
+    const Point<float> &left = *(right - 1);
+
+    const float deltaX = right->getX() - left.getX();
+
+    if (deltaX <= 0.0f)
+        return right->getY();
+
+    return wolf::lerp(left.getY(), right->getY(), (x - left.getX()) / deltaX);
+}
+
 void GraphWidgetInner::drawGraphEdge(int vertexIndex, float lineWidth, Color color)
 {
     DISTRHO_SAFE_ASSERT(vertexIndex < lineEditor.getVertexCount() - 1);
 
-    const float width = getWidth();
-    const float height = getHeight();
-
-    wolf::Vertex *leftVertex = lineEditor.getVertexAtIndex(vertexIndex);
-    wolf::Vertex *rightVertex = lineEditor.getVertexAtIndex(vertexIndex + 1);
+    updateCurvePoints();
 
     beginPath();
 
@@ -445,19 +595,16 @@ void GraphWidgetInner::drawGraphEdge(int vertexIndex, float lineWidth, Color col
     strokeWidth(lineWidth);
     lineJoin(ROUND);
 
-    moveTo(leftVertex->getX() * width, leftVertex->getY() * height);
+    const int start = fEdgeStarts[vertexIndex];
+    const int end = fEdgeStarts[vertexIndex + 1];
 
-    const float edgeLength = (rightVertex->getX() - leftVertex->getX()) * width;
+    moveTo(fCurvePoints[start].getX(), fCurvePoints[start].getY());
 
-    for (int i = 0; i <= edgeLength; ++i)
+    for (int i = start + 1; i < end; ++i)
     {
-        const float normalizedX = leftVertex->getX() + i / width;
-
-        lineTo(normalizedX * width, lineEditor.getValueAt(normalizedX) * height);
+        lineTo(fCurvePoints[i].getX(), fCurvePoints[i].getY());
     }
 
-    lineTo(rightVertex->getX() * width, rightVertex->getY() * height);
-
     stroke();
 
     closePath();
@@ -508,35 +655,21 @@ void GraphWidgetInner::drawGradient()
     const float width = getWidth();
     const float height = getHeight();
 
-    float peak = 0.0f;
+    updateCurvePoints();
 
     beginPath();
 
     moveTo(0, lineEditor.getVertexAtIndex(0)->getY() * height);
 
-    for (int vertexIndex = 0; vertexIndex < lineEditor.getVertexCount() - 1; ++vertexIndex)
+    for (const Point<float> &point : fCurvePoints)
     {
-        wolf::Vertex *leftVertex = lineEditor.getVertexAtIndex(vertexIndex);
-        wolf::Vertex *rightVertex = lineEditor.getVertexAtIndex(vertexIndex + 1);
-
-        const float edgeLength = (rightVertex->getX() - leftVertex->getX()) * width;
-
-        for (int i = 0; i <= edgeLength; ++i)
-        {
-            const float normalizedX = leftVertex->getX() + i / width;
-            const float x = normalizedX * width;
-            const float y = lineEditor.getValueAt(normalizedX) * height;
-
-            lineTo(x, y);
-
-            peak = std::max(peak, y);
-        }
+        lineTo(point.getX(), point.getY());
     }
 
     lineTo(width, 0);
     lineTo(0, 0);
 
-    fillPaint(linearGradient(width / 2.0f, 0, width / 2.0f, peak, CONFIG_NAMESPACE::graph_gradient_icol, CONFIG_NAMESPACE::graph_gradient_ocol));
+    fillPaint(linearGradient(width / 2.0f, 0, width / 2.0f, fCurvePeak, CONFIG_NAMESPACE::graph_gradient_icol, CONFIG_NAMESPACE::graph_gradient_ocol));
     fill();
 
     closePath();
@@ -544,13 +677,56 @@ void GraphWidgetInner::drawGradient()
 
 void GraphWidgetInner::updateInput(const float input)
 {
+    if (input == fInput)
+        return;
+
     fInput = input;
+
+    fFrameScheduler->markDirty(this, FrameScheduler::InputChanged);
+}
+
+void GraphWidgetInner::updateInputEnvelope(const EnvelopeCapture::Frame *frames, const int count)
+{
+    //per update, so that the density shows the last second or so of input
+    const float inputDensityDecay = 0.92f;
+
+    bool wasEmpty = true;
+
+    for (int i = 0; i < inputDensityBins; ++i)
+    {
+        wasEmpty = wasEmpty && fInputDensity[i] < 0.001f;
+        fInputDensity[i] *= inputDensityDecay;
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        const EnvelopeCapture::Frame &frame = frames[i];
+
+        //the graph maps the magnitude of the input, so a frame crossing zero covers everything below its peak
+        const float peak = std::max(std::abs(frame.min), std::abs(frame.max));
+        const float trough = frame.min < 0.0f && frame.max > 0.0f ? 0.0f : std::min(std::abs(frame.min), std::abs(frame.max));
+
+        const int first = std::min((int)(wolf::clamp(trough, 0.0f, 1.0f) * inputDensityBins), inputDensityBins - 1);
+        const int last = std::min((int)(wolf::clamp(peak, 0.0f, 1.0f) * inputDensityBins), inputDensityBins - 1);
+        const float weight = 1.0f / (last - first + 1);
+
+        for (int bin = first; bin <= last; ++bin)
+        {
+            fInputDensity[bin] += weight;
+        }
+
+        //the rms is where the signal sits most of the time
+        fInputDensity[std::min((int)(wolf::clamp(frame.rms, 0.0f, 1.0f) * inputDensityBins), inputDensityBins - 1)] += 1.0f;
+    }
+
+    if (count > 0 || !wasEmpty)
+        fFrameScheduler->markDirty(this, FrameScheduler::InputChanged);
 }
 
 void GraphWidgetInner::setGraphGradientMode(GraphGradientMode graphGradientMode)
 {
     this->graphGradientMode = graphGradientMode;
-    repaint();
+    fFrameScheduler->markDirty(this, FrameScheduler::StateChanged);
 }
 
 void GraphWidgetInner::setHorizontalWarpAmount(const float warpAmount)
@@ -580,7 +756,45 @@ void GraphWidgetInner::setVerticalWarpType(const wolf::WarpType warpType)
 void GraphWidgetInner::setMustHideVertices(const bool hide)
 {
     mustHideVertices = hide;
-    repaint();
+    fFrameScheduler->markDirty(this, FrameScheduler::StateChanged);
+}
+
+void GraphWidgetInner::drawInputDensity()
+{
+    const float maxDensity = *std::max_element(fInputDensity, fInputDensity + inputDensityBins);
+
+    if (maxDensity < 0.001f)
+        return;
+
+    const float width = getWidth();
+    const float binWidth = width / inputDensityBins;
+
+    updateCurvePoints();
+
+    //one path for all the bins, so the overlay is a single fill
+    beginPath();
+
+    moveTo(0, 0);
+
+    for (int i = 0; i < inputDensityBins; ++i)
+    {
+        const float left = i * binWidth;
+        const float right = left + binWidth;
+        const float height = getCurveHeightAt((left + right) / 2.0f) * fInputDensity[i] / maxDensity;
+
+        lineTo(left, height);
+        lineTo(right, height);
+    }
+
+    lineTo(width, 0);
+
+    Color densityColor = CONFIG_NAMESPACE::input_volume_indicator;
+    densityColor.alpha *= 0.35f;
+
+    fillColor(densityColor);
+    fill();
+
+    closePath();
 }
 
 void GraphWidgetInner::drawInputIndicator()
@@ -610,7 +824,9 @@ void GraphWidgetInner::drawInputIndicator()
     translate(-0.5f, -0.5f);
 
     //circle at indicator intersection with the graph
-    const float circleY = lineEditor.getValueAt(fInput) * height;
+    updateCurvePoints();
+
+    const float circleY = getCurveHeightAt(fInput * width);
 
     beginPath();
 
@@ -623,11 +839,6 @@ void GraphWidgetInner::drawInputIndicator()
     closePath();
 }
 
-void GraphWidgetInner::idleCallback()
-{
-    repaint();
-}
-
 void GraphWidgetInner::drawInOutLabels()
 {
     fontFace("chivo_italic");
@@ -675,7 +886,7 @@ bool GraphWidgetInner::onScroll(const ScrollEvent &ev)
             lineEditor.setTensionAtIndex(i, wolf::clamp(oldTension + 1.5f * delta, -100.0f, 100.0f));
 
             ui->setState("graph", lineEditor.serialize());
-            repaint();
+            fFrameScheduler->markDirty(this, FrameScheduler::StateChanged);
 
             getParentWindow().setCursorPos(tensionHandle->getAbsoluteX(), tensionHandle->getAbsoluteY());
 
@@ -711,14 +922,14 @@ void GraphWidgetInner::removeVertex(int index)
 
     focusedElement = nullptr;
 
-    repaint();
+    fFrameScheduler->markDirty(this, FrameScheduler::StateChanged);
 }
 
 GraphVertex *GraphWidgetInner::insertVertex(const Point<int> pos)
 {
     int i = lineEditor.getVertexCount();
 
-    if (i == wolf::maxVertices)
+    if (i == lineEditor.getVertexCapacity())
         return nullptr;
 
     while ((i > 0) && (pos.getX() < graphVertices[i - 1]->getX()))
@@ -750,27 +961,100 @@ GraphVertex *GraphWidgetInner::insertVertex(const Point<int> pos)
     return vertex;
 }
 
-GraphNode *GraphWidgetInner::getHoveredNode(Point<int> cursorPos)
+//at least the hit radius of the nodes, so that the cells around the cursor hold every node it can touch
+static const int nodeCellSize = 16;
+
+GraphNode *GraphWidgetInner::getIndexedNode(int id) const
+{
+    if (id < wolf::Graph::vertexCapacity)
+        return graphVertices[id];
+
+    return &graphVertices[id - wolf::Graph::vertexCapacity]->tensionHandle;
+}
+
+void GraphWidgetInner::updateNodeIndex()
 {
-    //Testing for mouse hover on graph vertices
-    for (int i = lineEditor.getVertexCount() - 1; i >= 0; --i)
+    if (!fNodeCells.empty() && fNodeIndexRevision == lineEditor.getRevision() && fNodeIndexWidth == getWidth() && fNodeIndexHeight == getHeight())
+        return;
+
+    rebuildNodeIndex();
+}
+
+void GraphWidgetInner::rebuildNodeIndex()
+{
+    const int vertexCount = lineEditor.getVertexCount();
+
+    fNodeCellColumns = getWidth() / nodeCellSize + 1;
+    fNodeCellRows = getHeight() / nodeCellSize + 1;
+
+    fNodeCells.assign(fNodeCellColumns * fNodeCellRows, -1);
+
+    //stamp the index first, since reading the position of a tension handle checks it
+    fNodeIndexRevision = lineEditor.getRevision();
+    fNodeIndexWidth = getWidth();
+    fNodeIndexHeight = getHeight();
+
+    for (int i = 0; i < vertexCount; ++i)
     {
-        if (graphVertices[i]->contains(cursorPos))
+        GraphVertex *vertex = graphVertices[i];
+
+        int nodes[2] = {i, wolf::Graph::vertexCapacity + i};
+        int nodeCount = 1;
+
+        if (i < vertexCount - 1)
         {
-            return graphVertices[i];
+            vertex->tensionHandle.updatePosition();
+            ++nodeCount;
+        }
+
+        for (int j = 0; j < nodeCount; ++j)
+        {
+            const GraphNode *node = getIndexedNode(nodes[j]);
+
+            const int column = wolf::clamp<int>(node->getX() / nodeCellSize, 0, fNodeCellColumns - 1);
+            const int row = wolf::clamp<int>(node->getY() / nodeCellSize, 0, fNodeCellRows - 1);
+            const int cell = row * fNodeCellColumns + column;
+
+            fNextNodeInCell[nodes[j]] = fNodeCells[cell];
+            fNodeCells[cell] = nodes[j];
         }
     }
+}
 
-    //Testing for mouse hover on tension handles
-    for (int i = lineEditor.getVertexCount() - 1; i >= 0; --i)
+GraphNode *GraphWidgetInner::getHoveredNode(Point<int> cursorPos)
+{
+    updateNodeIndex();
+
+    const int column = wolf::clamp<int>(cursorPos.getX() / nodeCellSize, 0, fNodeCellColumns - 1);
+    const int row = wolf::clamp<int>(cursorPos.getY() / nodeCellSize, 0, fNodeCellRows - 1);
+
+    GraphNode *hoveredNode = nullptr;
+    int hoveredRank = -1;
+
+    for (int y = std::max(row - 1, 0); y <= std::min(row + 1, fNodeCellRows - 1); ++y)
     {
-        if (graphVertices[i]->tensionHandle.contains(cursorPos))
+        for (int x = std::max(column - 1, 0); x <= std::min(column + 1, fNodeCellColumns - 1); ++x)
         {
-            return &graphVertices[i]->tensionHandle;
+            for (int id = fNodeCells[y * fNodeCellColumns + x]; id != -1; id = fNextNodeInCell[id])
+            {
+                //vertices come before tension handles, and rightmost nodes first
+                const int rank = id < wolf::Graph::vertexCapacity ? wolf::Graph::vertexCapacity + id : id - wolf::Graph::vertexCapacity;
+
+                if (rank < hoveredRank)
+                    continue;
+
+                GraphNode *node = getIndexedNode(id);
+
+                if (node->contains(cursorPos))
+                {
+                    hoveredNode = node;
+                    hoveredRank = rank;
+                }
+            }
         }
     }
 
-    return nullptr;
+    return hoveredNode;
 }
 
 bool GraphWidgetInner::leftClick(const MouseEvent &ev)
@@ -827,7 +1111,7 @@ void GraphWidgetInner::menuItemSelected(const int id)
         fLastCurveTypeSelected = type;
 
         ui->setState("graph", lineEditor.serialize());
-        repaint();
+        fFrameScheduler->markDirty(this, FrameScheduler::StateChanged);
     }
 }
 
@@ -873,7 +1157,7 @@ bool GraphWidgetInner::rightClick(const MouseEvent &ev)
                     getParentWindow().setCursorStyle(Window::CursorStyle::Default);
                 }
 
-                repaint();
+                fFrameScheduler->markDirty(this, FrameScheduler::StateChanged);
             }
 
             //else, show curve selection menu
@@ -1005,7 +1289,7 @@ void GraphWidgetInner::onFocusOut()
 
     getParentWindow().showCursor();
 
-    repaint();
+    fFrameScheduler->markDirty(this, FrameScheduler::StateChanged);
 }
 
 void GraphWidgetInner::onMouseLeave()
@@ -1,14 +1,19 @@
 #include "MenuWidget.hpp"
 #include "Config.hpp"
+#include <cmath>
+#include <cstring>
 #include <iostream>
 
 START_NAMESPACE_DISTRHO
 
 MenuWidget::MenuWidget( NanoWidget *widget ) noexcept
 	: WolfWidget(widget),
+	  labels(1, '\0'),
+	  layout_dirty(true),
+	  line_h_px(0),
+	  max_item_w_px(0),
 	  hover_i(-1),
 	  selected_i(-1),
-	  max_item_w_px(0),
 	  margin(Margin(7,15,7,13)),
 	  font_item_size(17.0f),
 	  font_item_color(255,255,255),
@@ -26,7 +31,7 @@ void MenuWidget::show(const Point<int>& click_pos,
 	const Rectangle<int>& parent_widget_bounds)
 {
 	this->parent_widget_bounds = parent_widget_bounds;
-	adaptSize();
+	updateLayout();
 
 	// move the menuwidget so that it always appears within the parent widget
 	// bounds
@@ -57,30 +62,32 @@ void MenuWidget::hide()
 void MenuWidget::clear()
 {
 	items.clear();
+	labels.assign(1, '\0');
 	max_item_w_px = 0;
 	hover_i = -1;
 	selected_i = -1;
+	layout_dirty = true;
 }
 
 void MenuWidget::addSection(const char* sectionName)
 {
-	Item item = Item(sectionName);
-	items.push_back(item);
-	updateMaxItemWidth(item);
+	items.push_back(Item(internLabel(sectionName)));
+	layout_dirty = true;
 }
 
 void MenuWidget::addItem(int id, const char *label, const char *comment)
 {
 	DISTRHO_SAFE_ASSERT(id >= 0)
-	Item item = Item(id, std::string(label), std::string(comment));
-	items.push_back(item);
-	updateMaxItemWidth(item);
+	const uint name_offset = internLabel(label);
+	const uint description_offset = internLabel(comment);
+	items.push_back(Item(id, name_offset, description_offset));
+	layout_dirty = true;
 }
 
 auto MenuWidget::findItemIndex(const std::string& name) -> int
 {
 	for (size_t i = 0; i < items.size(); ++i) {
-		if (items[i].name == name) return i;
+		if (name == getLabel(items[i].name_offset)) return i;
 	}
 	return -1;
 }
@@ -117,17 +124,21 @@ void MenuWidget::setItemSelected(const uint i)
 void MenuWidget::setRegularFontSize(const uint size) noexcept
 {
 	this->font_item_size = size;
+	layout_dirty = true;
 }
 
 void MenuWidget::setSectionFontSize(const uint size) noexcept
 {
 	this->font_section_size = size;
+	layout_dirty = true;
 }
 
 void MenuWidget::onNanoDisplay()
 {
 	if (items.size() == 0) return; // don't render an empty menu
 
+	updateLayout();
+
 	const float h = NanoWidget::getHeight();
 	const float w = NanoWidget::getWidth();
 
@@ -135,12 +146,6 @@ void MenuWidget::onNanoDisplay()
 
 	textAlign(ALIGN_LEFT | ALIGN_TOP);
 
-	// these four lines are used to calculate the height of a line of text
-	Rectangle<float> bounds;
-	fontSize(font_item_size);
-	textBounds(0, 0, items[0].name.c_str(), NULL, bounds);
-	const float text_h = bounds.getHeight();
-
 	fillColor(background_color);
 	strokeColor(border_color);
 	strokeWidth(3.0f);
@@ -192,25 +197,21 @@ void MenuWidget::onNanoDisplay()
 			}
 		}
 
-		text(left_offset, vertical_offset, item.name.c_str(), NULL);
+		text(left_offset, vertical_offset, getLabel(item.name_offset), NULL);
 
 		if (static_cast<int>(i) == selected_i) {
 			text(0, vertical_offset, "✓", NULL);
 		}
 
 		// render description if an item has one
-		if (item.description.size() > 0) {
-			Rectangle<float> name_bounds;
-			fontSize(font_item_size);
-			textBounds(0,0, item.name.c_str(), NULL, name_bounds);
-
+		if (item.description_offset != 0) {
 			fontSize(font_section_size);
 			fillColor(font_section_color);
-			text(name_bounds.getWidth() + font_item_size,
-				 vertical_offset, item.description.c_str(), NULL);
+			text(item.name_w_px + font_item_size,
+				 vertical_offset, getLabel(item.description_offset), NULL);
 		}
 
-		vertical_offset += text_h;
+		vertical_offset += line_h_px;
 
 		closePath();
 	}
@@ -232,23 +233,13 @@ auto MenuWidget::onMouse(const MouseEvent& ev) -> bool
 			return true;
 		}
 
-		bool cur_section_enabled = true;
-		for (size_t i = 0; i < items.size(); ++i) {
-			const bool is_section = items[i].is_section;
-			if (is_section) cur_section_enabled = items[i].enabled;
-			bool is_enabled = cur_section_enabled && items[i].enabled;
-
-			if (!is_section && is_enabled) {
-				Rectangle<float> bounds = getItemBoundsPx(i);
-				bounds.setWidth(Widget::getWidth() - margin.right);
-
-				if (bounds.contains(mouse_pos)) {
-					callback->menuItemSelected(items[i].id);
-					selected_i = i;
-					NanoWidget::hide();
-					return true;
-				}
-			}
+		const int i = getItemIndexAt(mouse_pos);
+
+		if (i != -1 && !items[i].is_section && isItemEnabled(i)) {
+			callback->menuItemSelected(items[i].id);
+			selected_i = i;
+			NanoWidget::hide();
+			return true;
 		}
 	}
 	return true;
@@ -269,21 +260,16 @@ auto MenuWidget::onMotion(const MotionEvent& ev) -> bool
 	const auto menu_bounds = getBounds<int>();
 	if (menu_bounds.contains(ev.pos)) {
 		// update hover_i
-		for (size_t i = 0; i < items.size(); ++i) {
-			Rectangle<float> bounds = getItemBoundsPx(i);
-			bounds.setWidth(Widget::getWidth() - margin.right);
-			const Point<float> mouse_pos = Point<float>(
-				static_cast<float>(ev.pos.getX()),
-				static_cast<float>(ev.pos.getY())
-			);
-
-			if (static_cast<int>(i) != selected_i
-				&& !items[i].is_section
-				&& bounds.contains(mouse_pos)) {
-				getParentWindow().setCursorStyle(Window::CursorStyle::Grab);
-				hover_i = i;
-				return true;
-			}
+		const Point<float> mouse_pos = Point<float>(
+			static_cast<float>(ev.pos.getX()),
+			static_cast<float>(ev.pos.getY())
+		);
+		const int i = getItemIndexAt(mouse_pos);
+
+		if (i != -1 && i != selected_i && !items[i].is_section) {
+			getParentWindow().setCursorStyle(Window::CursorStyle::Grab);
+			hover_i = i;
+			return true;
 		}
 	}
 	getParentWindow().setCursorStyle(Window::CursorStyle::Default);
@@ -291,47 +277,109 @@ auto MenuWidget::onMotion(const MotionEvent& ev) -> bool
 	return true;
 }
 
-void MenuWidget::updateMaxItemWidth(const Item& item)
+auto MenuWidget::internLabel(const char *label) -> uint
 {
-	max_item_w_px = std::max(max_item_w_px, getItemWidthPx(item));
+	// all empty labels share the string at offset 0
+	if (label == nullptr || label[0] == '\0') return 0;
+
+	const uint offset = labels.size();
+	labels.insert(labels.end(), label, label + std::strlen(label) + 1);
+	return offset;
 }
 
-void MenuWidget::adaptSize()
+auto MenuWidget::getLabel(const uint offset) const -> const char*
 {
-	NanoWidget::setSize(Size<uint>(
-		max_item_w_px + margin.left + margin.right + font_section_size,
-		items.size()*font_item_size + margin.top + margin.bottom
-	));
+	return &labels[offset];
 }
 
-auto MenuWidget::getItemWidthPx(const Item& item) -> float
+void MenuWidget::measureItem(Item& item)
 {
+	Rectangle<float> bounds;
+
 	if (item.is_section) {
-		Rectangle<float> bounds;
 		fontSize(font_section_size);
-		textBounds(0, 0, (item.name + item.description).c_str(), NULL, bounds);
-		return bounds.getWidth();
+		textBounds(0, 0, getLabel(item.name_offset), NULL, bounds);
+		item.name_w_px = bounds.getWidth();
+		item.description_w_px = 0;
 	} else {
-		Rectangle<float> bounds_item, bounds_section;
 		fontSize(font_item_size);
-		textBounds(0,0,item.name.c_str(), NULL, bounds_item);
-		if (item.description.length() > 0)
+		textBounds(0, 0, getLabel(item.name_offset), NULL, bounds);
+		item.name_w_px = bounds.getWidth();
+		item.description_w_px = 0;
+		if (item.description_offset != 0)
 		{
 			fontSize(font_section_size);
-			textBounds(0,0,item.description.c_str(), NULL, bounds_section);
+			textBounds(0, 0, getLabel(item.description_offset), NULL, bounds);
+			item.description_w_px = bounds.getWidth();
 		}
-		return bounds_item.getWidth() + bounds_section.getWidth();
 	}
 }
 
-auto MenuWidget::getItemBoundsPx(const int index) -> Rectangle<float>
+void MenuWidget::updateLayout()
 {
-	fontSize(font_item_size);
+	if (!layout_dirty) return;
+	layout_dirty = false;
+
 	textAlign(ALIGN_LEFT | ALIGN_TOP);
-	Rectangle<float> bounds;
-	textBounds(margin.left, index*font_item_size + margin.top,
-		items[index].name.c_str(), NULL, bounds);
-	return bounds;
+
+	max_item_w_px = 0;
+	for (auto &item : items) {
+		measureItem(item);
+		max_item_w_px = std::max(max_item_w_px, item.name_w_px + item.description_w_px);
+	}
+
+	// the height of a line of text
+	line_h_px = 0;
+	if (items.size() > 0) {
+		Rectangle<float> bounds;
+		fontSize(font_item_size);
+		textBounds(0, 0, getLabel(items[0].name_offset), NULL, bounds);
+		line_h_px = bounds.getHeight();
+	}
+
+	NanoWidget::setSize(Size<uint>(
+		max_item_w_px + margin.left + margin.right + font_section_size,
+		items.size()*font_item_size + margin.top + margin.bottom
+	));
+
+	// rows are font_item_size apart, and as wide as the menu minus its right margin
+	item_bounds.clear();
+	for (size_t i = 0; i < items.size(); ++i) {
+		item_bounds.push_back(Rectangle<float>(
+			margin.left, margin.top + i*font_item_size,
+			Widget::getWidth() - margin.right, line_h_px
+		));
+	}
+}
+
+DGL_NAMESPACE::Rectangle<float> MenuWidget::getBoundsOfItem(const int i)
+{
+	updateLayout();
+
+	DISTRHO_SAFE_ASSERT_RETURN(i >= 0 && (size_t)i < item_bounds.size(), DGL_NAMESPACE::Rectangle<float>());
+
+	return item_bounds[i];
+}
+
+auto MenuWidget::getItemIndexAt(const Point<float>& pos) const -> int
+{
+	if (layout_dirty || font_item_size <= 0) return -1;
+
+	const int i = std::floor((pos.getY() - margin.top) / font_item_size);
+	if (i < 0 || i >= static_cast<int>(item_bounds.size())) return -1;
+
+	return item_bounds[i].contains(pos) ? i : -1;
+}
+
+auto MenuWidget::isItemEnabled(const int index) const -> bool
+{
+	if (!items[index].enabled) return false;
+
+	// items are disabled along with the section they belong to
+	for (int i = index; i >= 0; --i) {
+		if (items[i].is_section) return items[i].enabled;
+	}
+	return true;
 }
 
 END_NAMESPACE_DISTRHO
@@ -1,5 +1,4 @@
 #include "MixerStrip.hpp"
-#include "nanovg.h"
 #include "Mathf.hpp"
 #include "CarlaMixer.hpp"
 
@@ -9,7 +8,9 @@ MixerStrip::MixerStrip(CarlaMixer *mixer, Size<uint> size) noexcept : NanoWidget
 {
     setSize(size);
 
-    fNoiseTexture = generateNoiseTexture();
+    //the texture is the same for every strip of that size, so it's only generated once
+    fResources = ResourceCache::attach(this);
+    fNoiseTexture = fResources->acquireNoiseTexture(size);
 
     fMuteSwitch = new MixerSwitch(this, Size<uint>(36, 27));
     fMuteSwitch->setType(MixerSwitch::MuteMixerSwitch);
@@ -49,50 +50,10 @@ void MixerStrip::positionWidgets()
     fMeter->setAbsolutePos(absX + 35, absY + 79);
 }
 
-NanoVG::Paint MixerStrip::generateNoiseTexture()
+MixerStrip::~MixerStrip()
 {
-    NVGcontext *context = getContext();
-
-    const int width = getWidth();
-    const int height = getHeight();
-
-    unsigned char *imageData = (unsigned char *)malloc(width * height * 4);
-
-    int fileId = nvgCreateImageRGBA(context, width, height, 0, imageData);
-
-    for (int i = 0; i < height; ++i)
-    {
-        for (int j = 0; j < width; ++j)
-        {
-            int index = i * (width * 4) + (j * 4);
-
-            int min = 0;
-            int max = 8;
-            int noiseFloor = 5;
-
-            int random = min + (std::rand() % static_cast<int>(max - min + 1));
-
-            float t;
-
-            if (random > noiseFloor)
-            {
-                t = (float)random / max;
-            }
-            else
-            {
-                t = 0;
-            }
-
-            imageData[index + 0] = wolf::lerp(35, 40, t);
-            imageData[index + 1] = wolf::lerp(38, 43, t);
-            imageData[index + 2] = wolf::lerp(41, 44, t);
-            imageData[index + 3] = 255;
-        }
-    }
-
-    nvgUpdateImage(context, fileId, imageData);
-
-    return nvgImagePattern(context, 0, 0, width, height, 0, fileId, 1.0f);
+    fResources->release(fNoiseTexture);
+    ResourceCache::detach(this);
 }
 
 void MixerStrip::onNanoDisplay()
@@ -104,7 +65,7 @@ void MixerStrip::onNanoDisplay()
 
     beginPath();
 
-    fillPaint(fNoiseTexture);
+    fillPaint(fNoiseTexture->paints[0]);
     rect(0, 0, width, height);
     fill();
     closePath();
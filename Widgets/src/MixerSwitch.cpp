@@ -3,15 +3,16 @@
 START_NAMESPACE_DISTRHO
 
 MixerSwitch::MixerSwitch(NanoWidget *widget, Size<uint> size) noexcept : NanoSwitch(widget, size),
+                                                                         fFrameScheduler(FrameScheduler::attach(this)),
 
                                                                          fSocketColor(27, 27, 27, 255),
-                                                                         fSocketColorTransition(0.080f, &fSocketColor, Color(59, 36, 148, 255)),
+                                                                         fSocketColorTransition(fFrameScheduler->getAnimationEngine(), 0.080f, &fSocketColor, Color(59, 36, 148, 255)),
 
                                                                          fGlowIcol(Color(82, 238, 248, 0)),
-                                                                         fGlowIcolTransition(0.200f, &fGlowIcol, Color(82, 238, 248, 125)),
+                                                                         fGlowIcolTransition(fFrameScheduler->getAnimationEngine(), 0.200f, &fGlowIcol, Color(82, 238, 248, 125)),
 
                                                                          fMainRectColor(Color(73, 73, 73, 255)),
-                                                                         fMainRectColorTransition(0.150f, &fMainRectColor, Color(82, 238, 248, 255)),
+                                                                         fMainRectColorTransition(fFrameScheduler->getAnimationEngine(), 0.150f, &fMainRectColor, Color(82, 238, 248, 255)),
 
                                                                          fMixerSwitchType(MuteMixerSwitch)
 {
@@ -26,12 +27,10 @@ MixerSwitch::MixerSwitch(NanoWidget *widget, Size<uint> size) noexcept : NanoSwi
     const float mainRectHalfWidth = mainRectWidth / 2.0f;
     const float mainRectCenter = mainRectTopLeft + mainRectHalfWidth;
 
-    widget->getParentWindow().addIdleCallback(this);
-
     const Paint targetGradient = radialGradient(mainRectCenter, mainRectCenter, 0.5f, mainRectHalfWidth, Color(254, 224, 191, 255), Color(240, 199, 154, 0));
 
     fMainRectGradient = radialGradient(mainRectCenter, mainRectCenter, 0.5f, mainRectHalfWidth, Color(93, 103, 111, 255), Color(93, 103, 111, 255));
-    fMainRectGradientTransition = GradientTransition(0.010f, &fMainRectGradient, targetGradient);
+    fMainRectGradientTransition = GradientTransition(fFrameScheduler->getAnimationEngine(), 0.010f, &fMainRectGradient, targetGradient);
 
     loadSharedResources();
 }
@@ -41,36 +40,9 @@ void MixerSwitch::setType(MixerSwitchType type)
     fMixerSwitchType = type;
 }
 
-void MixerSwitch::idleCallback()
+MixerSwitch::~MixerSwitch()
 {
-    bool mustRepaint = false;
-
-    if (fSocketColorTransition.isPlaying())
-    {
-        fSocketColorTransition.run();
-        mustRepaint = true;
-    }
-
-    if (fGlowIcolTransition.isPlaying())
-    {
-        fGlowIcolTransition.run();
-        mustRepaint = true;
-    }
-
-    if (fMainRectColorTransition.isPlaying())
-    {
-        fMainRectColorTransition.run();
-        mustRepaint = true;
-    }
-
-    if (fMainRectGradientTransition.isPlaying())
-    {
-        fMainRectGradientTransition.run();
-        mustRepaint = true;
-    }
-
-    if (mustRepaint)
-        repaint();
+    FrameScheduler::detach(this);
 }
 
 void MixerSwitch::onStateChanged()
@@ -79,6 +51,10 @@ void MixerSwitch::onStateChanged()
     fGlowIcolTransition.play(isDown() ? Animation::Forward : Animation::Backward);
     fMainRectColorTransition.play(isDown() ? Animation::Forward : Animation::Backward);
 
+    fFrameScheduler->runAnimation(&fSocketColorTransition, this);
+    fFrameScheduler->runAnimation(&fGlowIcolTransition, this);
+    fFrameScheduler->runAnimation(&fMainRectColorTransition, this);
+
     if (isDown())
     {
         fMainRectGradientTransition.setSpeed(1.0f);
@@ -89,6 +65,8 @@ void MixerSwitch::onStateChanged()
         fMainRectGradientTransition.setSpeed(1.0f / 15.0f);
         fMainRectGradientTransition.play(Animation::Backward);
     }
+
+    fFrameScheduler->runAnimation(&fMainRectGradientTransition, this);
 }
 
 void MixerSwitch::draw()
@@ -1,15 +1,63 @@
 #include "NanoMeter.hpp"
+#include "nanovg.h"
 
 START_NAMESPACE_DISTRHO
 
+static const float socketStrokeWidth = 1.5f;
+static const float glassStrokeWidth = 1.0f;
+static const float glassRectXY = glassStrokeWidth + socketStrokeWidth + 0.5f;
+static const float metersXY = glassRectXY + 1.5f;
+
+enum MeterPaints
+{
+    GlassFill = 0,
+    GlassStroke,
+    RedToYellow,
+    YellowToBase
+};
+
+static void buildMeterPaints(NVGcontext *context, Size<uint> size, Color color, NanoVG::Paint *paints)
+{
+    static const Color kColorRed(255, 0, 0);
+    static const Color kColorYellow(255, 255, 0);
+
+    const float height = size.getHeight();
+    const float halfWidth = size.getWidth() / 2.0f;
+
+    const Color glassTopColor = Color(32, 32, 32, 255);
+    const Color glassBottomColor = Color(7, 7, 7, 255);
+
+    const Color glassTopOutlineColor = Color(74, 74, 74, 100);
+    const Color glassBottomOutlineColor = Color(74, 74, 74, 0);
+
+    paints[GlassFill] = nvgLinearGradient(context, halfWidth, 0, halfWidth, height, glassTopColor, glassBottomColor);
+    paints[GlassStroke] = nvgLinearGradient(context, halfWidth, 0, halfWidth, height, glassTopOutlineColor, glassBottomOutlineColor);
+
+    const float meterHeight = height - metersXY * 2.0f;
+    const float redYellowHeight = meterHeight * 0.2f;
+    const float yellowBaseHeight = meterHeight * 0.4f;
+
+    paints[RedToYellow] = nvgLinearGradient(context, 0.0f, 0.0f, 0.0f, redYellowHeight, kColorRed, kColorYellow);
+    paints[YellowToBase] = nvgLinearGradient(context, 0.0f, redYellowHeight, 0.0f, yellowBaseHeight, kColorYellow, color);
+}
+
 NanoMeter::NanoMeter(NanoWidget *widget, Size<uint> size) noexcept : NanoWidget(widget),
                                                                      fEnabled(true),
                                                                      fOutLeft(0),
-                                                                     fOutRight(0)
+                                                                     fOutRight(0),
+                                                                     fPaints(nullptr)
 {
     setSize(size);
 
     fColor = Color(31,208,215);
+
+    fResources = ResourceCache::attach(this);
+}
+
+NanoMeter::~NanoMeter()
+{
+    fResources->release(fPaints);
+    ResourceCache::detach(this);
 }
 
 void NanoMeter::setOutLeft(float value) noexcept
@@ -51,10 +99,6 @@ void NanoMeter::setEnabled(bool enabled)
 
 void NanoMeter::onNanoDisplay()
 {
-    static const Color kColorBlack(0, 0, 0);
-    static const Color kColorRed(255, 0, 0);
-    static const Color kColorYellow(255, 255, 0);
-
     const float outLeft(fOutLeft);
     const float outRight(fOutRight);
 
@@ -62,14 +106,19 @@ void NanoMeter::onNanoDisplay()
     const float height = getHeight();
     const float halfWidth = static_cast<float>(getWidth()) / 2.0f;
 
+    //the gradients only depend on the size and the color, so meters alike share them
+    if (fPaints == nullptr || fPaints->size != getSize())
+    {
+        fResources->release(fPaints);
+        fPaints = fResources->acquirePaints("NanoMeter", getSize(), fColor, buildMeterPaints);
+    }
+
     // outline and socket
     beginPath();
 
     fillColor(Color(0, 0, 0, 255));
     strokeColor(Color(62, 71, 72, 205));
 
-    const float socketStrokeWidth = 1.5f;
-
     strokeWidth(socketStrokeWidth);
 
     roundedRect(socketStrokeWidth, socketStrokeWidth, width - socketStrokeWidth * 2.0f, height - socketStrokeWidth * 2.0f, 0.5f);
@@ -81,17 +130,9 @@ void NanoMeter::onNanoDisplay()
     // glass
     beginPath();
 
-    const Color glassTopColor = Color(32, 32, 32, 255);
-    const Color glassBottomColor = Color(7, 7, 7, 255);
+    fillPaint(fPaints->paints[GlassFill]);
+    strokePaint(fPaints->paints[GlassStroke]);
 
-    const Color glassTopOutlineColor = Color(74, 74, 74, 100);
-    const Color glassBottomOutlineColor = Color(74, 74, 74, 0);
-
-    fillPaint(linearGradient(halfWidth, 0, halfWidth, height, glassTopColor, glassBottomColor));
-    strokePaint(linearGradient(halfWidth, 0, halfWidth, height, glassTopOutlineColor, glassBottomOutlineColor));
-
-    const float glassStrokeWidth = 1.0f;
-    const float glassRectXY = glassStrokeWidth + socketStrokeWidth + 0.5f;
     const float doubleGlassRectXY = glassRectXY * 2.f;
 
     strokeWidth(glassStrokeWidth);
@@ -120,26 +161,17 @@ void NanoMeter::onNanoDisplay()
     closePath();
 
     // meters
-    const float metersXY = glassRectXY + 1.5f;
-    const float halfMetersXY = metersXY / 2.0f;
     const float leftRightMetersMargin = 1.0f;
     const float meterWidth = halfWidth - leftRightMetersMargin - glassRectXY * 2 + 2.0f;
     const float meterHeight = height - metersXY * 2.0f;
 
     const float redYellowHeight = meterHeight * 0.2f;
     const float yellowBaseHeight = meterHeight * 0.4f;
-    const float baseBaseHeight = meterHeight * 0.6f;
     const float baseY = metersXY + redYellowHeight + yellowBaseHeight;
     const float baseHeight = height - metersXY - baseY;
 
     const float meterBottom = height - metersXY;
 
-    const float meterLedsSpacing = 3;
-
-    // create gradients
-    Paint fGradient1 = linearGradient(0.0f, 0.0f, 0.0f, redYellowHeight, kColorRed, kColorYellow);
-    Paint fGradient2 = linearGradient(0.0f, redYellowHeight, 0.0f, yellowBaseHeight, kColorYellow, fColor);
-
     if (!fEnabled)
         globalAlpha(0.28f);
 
@@ -156,43 +188,21 @@ void NanoMeter::onNanoDisplay()
         beginPath();
 
         rect(metersXY, metersXY, meterWidth, redYellowHeight + 1.0f);
-        fillPaint(fGradient1);
+        fillPaint(fPaints->paints[RedToYellow]);
         fill();
 
         closePath();
 
+        //the yellow part and the base share a paint, so they go in the same path
         beginPath();
 
         rect(metersXY, metersXY + redYellowHeight, meterWidth, yellowBaseHeight + 1.0f);
-        fillPaint(fGradient2);
-        fill();
-
-        closePath();
-
-        beginPath();
-
         rect(metersXY, baseY, meterWidth, baseHeight);
 
-        fillPaint(fGradient2);
+        fillPaint(fPaints->paints[YellowToBase]);
         fill();
 
         closePath();
-
-        //lines
-        beginPath();
-
-        strokeColor(Color(0, 0, 255, 155));
-        strokeWidth(1.0f);
-
-        for (int j = 0; j < height; j += meterLedsSpacing)
-        {
-            moveTo(0, j);
-            lineTo(width, j);
-        }
-
-        //stroke();
-
-        closePath();
     }
 }
 
@@ -5,18 +5,39 @@
 START_NAMESPACE_DISTRHO
 
 SliderHandle::SliderHandle(NanoWidget *parent, Size<uint> size) noexcept : HasDropShadow(parent, Size<uint>(size.getWidth() + 10, size.getHeight() + 16)),
-                                                                           NanoWidget(parent)
+                                                                           NanoWidget(parent),
+                                                                           fImage(nullptr)
 {
     setSize(size);
 
-    fImage = nsvgParseFromFile("/home/spoonie/dsp/Carla-Mixer/resources/Widgets/slider.svg", "px", 75);
+    fResources = ResourceCache::attach(this);
+}
+
+void SliderHandle::setSvg(const char *path)
+{
+    //parsed once, for all the sliders using the same file
+    const ResourceCache::Resource *image = fResources->acquireSvg(path, "px", 75);
+
+    fResources->release(fImage);
+    fImage = image;
+
+    repaint();
+}
+
+SliderHandle::~SliderHandle()
+{
+    fResources->release(fImage);
+    ResourceCache::detach(this);
 }
 
 void SliderHandle::onNanoDisplay()
 {
     fDropShadow.setAbsolutePos(getAbsoluteX() - 2, getAbsoluteY() + 9);
 
-    SVGUtils::nvgDrawSVG(getContext(), fImage);
+    if (fImage == nullptr)
+        return;
+
+    SVGUtils::nvgDrawSVG(getContext(), fImage->svg);
 }
 
 NanoSlider::NanoSlider(NanoWidget *parent, Size<uint> size) noexcept
@@ -92,6 +113,11 @@ void NanoSlider::setHandleSize(const float width, const float height)
     fHandle->setSize(width, height);
 }
 
+void NanoSlider::setHandleSvg(const char *path)
+{
+    fHandle->setSvg(path);
+}
+
 void NanoSlider::setSocketMargin(const float top, const float bottom)
 {
     fSocketMarginBottom = bottom;
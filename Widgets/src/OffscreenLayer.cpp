@@ -0,0 +1,142 @@
+#include "OffscreenLayer.hpp"
+#include "Window.hpp"
+#include "OpenGL.hpp"
+
+#include "nanovg.h"
+
+//only the declarations: dpf builds the framebuffer helpers along with its nanovg backend
+#include "nanovg_gl_utils.h"
+
+START_NAMESPACE_DISTRHO
+
+OffscreenLayer::OffscreenLayer(NanoWidget *widget) : fWidget(widget),
+                                                     fFramebuffer(nullptr),
+                                                     fWidth(0),
+                                                     fHeight(0),
+                                                     fScaling(1.0f),
+                                                     fDirty(true),
+                                                     fRendering(false),
+                                                     fIsSupported(true)
+{
+}
+
+OffscreenLayer::~OffscreenLayer()
+{
+    if (fFramebuffer != nullptr)
+        nvgluDeleteFramebuffer(fFramebuffer);
+}
+
+void OffscreenLayer::invalidate()
+{
+    fDirty = true;
+}
+
+void OffscreenLayer::restartParentFrame()
+{
+    NVGcontext *context = fWidget->getContext();
+    const float scaling = fWidget->getParentWindow().getScaling();
+
+    //the same frame as the one of the parent, which drew to the viewport saved when it was interrupted
+    nvgBeginFrame(context, fParentViewport[2] / scaling, fParentViewport[3] / scaling, scaling);
+
+    //the transform is all the parent had set up for the widget, since the layer renders before anything else
+    nvgTransform(context, fParentTransform[0], fParentTransform[1], fParentTransform[2], fParentTransform[3], fParentTransform[4], fParentTransform[5]);
+}
+
+bool OffscreenLayer::beginRender()
+{
+    DISTRHO_SAFE_ASSERT_RETURN(!fRendering, false);
+
+    if (!fIsSupported)
+        return true;
+
+    const uint width = fWidget->getWidth();
+    const uint height = fWidget->getHeight();
+
+    const float scaling = fWidget->getParentWindow().getScaling();
+    const bool resized = width != fWidth || height != fHeight || scaling != fScaling;
+
+    if (!fDirty && fFramebuffer != nullptr && !resized)
+        return false;
+
+    if (width == 0 || height == 0)
+        return false;
+
+    NVGcontext *context = fWidget->getContext();
+
+    nvgCurrentTransform(context, fParentTransform);
+
+    //draw what the parent queued so far, since the frame is about to be interrupted
+    nvgEndFrame(context);
+
+    glGetIntegerv(GL_VIEWPORT, fParentViewport);
+
+    if (fFramebuffer == nullptr || resized)
+    {
+        if (fFramebuffer != nullptr)
+            nvgluDeleteFramebuffer(fFramebuffer);
+
+        //nanovg renders with premultiplied alpha, and upside down in a framebuffer
+        fFramebuffer = nvgluCreateFramebuffer(context, width * scaling, height * scaling, NVG_IMAGE_FLIPY | NVG_IMAGE_PREMULTIPLIED);
+
+        fWidth = width;
+        fHeight = height;
+        fScaling = scaling;
+    }
+
+    if (fFramebuffer == nullptr)
+    {
+        //no framebuffer objects with this backend: the content is drawn directly, every frame
+        fIsSupported = false;
+        restartParentFrame();
+
+        return true;
+    }
+
+    nvgluBindFramebuffer(fFramebuffer);
+
+    glViewport(0, 0, width * scaling, height * scaling);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+    nvgBeginFrame(context, width, height, scaling);
+
+    fRendering = true;
+
+    return true;
+}
+
+void OffscreenLayer::endRender()
+{
+    if (!fRendering)
+        return;
+
+    nvgEndFrame(fWidget->getContext());
+
+    //back to the framebuffer of the window
+    nvgluBindFramebuffer(nullptr);
+    glViewport(fParentViewport[0], fParentViewport[1], fParentViewport[2], fParentViewport[3]);
+
+    restartParentFrame();
+
+    fDirty = false;
+    fRendering = false;
+}
+
+void OffscreenLayer::draw()
+{
+    if (!fIsSupported || fFramebuffer == nullptr)
+        return;
+
+    NVGcontext *context = fWidget->getContext();
+
+    nvgBeginPath(context);
+
+    nvgRect(context, 0, 0, fWidth, fHeight);
+    nvgFillPaint(context, nvgImagePattern(context, 0, 0, fWidth, fHeight, 0, fFramebuffer->image, 1.0f));
+    nvgFill(context);
+
+    nvgClosePath(context);
+}
+
+END_NAMESPACE_DISTRHO
@@ -1,4 +1,5 @@
 #include "OversampleWheel.hpp"
+#include "FontRegistry.hpp"
 #include "Fonts/chivo_bold.hpp"
 
 START_NAMESPACE_DISTRHO
@@ -15,7 +16,8 @@ OversampleWheel::OversampleWheel(NanoWidget *widget, Size<uint> size) noexcept :
                                                                                  fFontSize(18.0f)
 {
     using namespace WOLF_FONTS;
-    createFontFromMemory("chivo_bold", (const uchar *)chivo_bold, chivo_bold_size, 0);
+    FontRegistry::add("chivo_bold", chivo_bold, chivo_bold_size);
+    FontRegistry::load(*this, "chivo_bold");
 }
 
 void OversampleWheel::drawTriangles()
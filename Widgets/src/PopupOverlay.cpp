@@ -0,0 +1,136 @@
+#include "PopupOverlay.hpp"
+
+#include <algorithm>
+
+START_NAMESPACE_DISTRHO
+
+//one overlay per window, shared by all its popups
+static std::vector<PopupOverlay *> overlays;
+
+PopupOverlay::PopupOverlay(Window &window) : NanoWidget(window),
+                                             fWindow(window),
+                                             fPopup(nullptr),
+                                             fPopupBounds()
+{
+    DISTRHO_SAFE_ASSERT(get(this) == nullptr);
+
+    loadSharedResources();
+
+    setVisible(false);
+
+    overlays.push_back(this);
+}
+
+PopupOverlay::~PopupOverlay()
+{
+    overlays.erase(std::remove(overlays.begin(), overlays.end(), this), overlays.end());
+
+    if (fPopup != nullptr)
+        fPopup->onPopupClosed();
+}
+
+PopupOverlay *PopupOverlay::get(Widget *widget)
+{
+    Window &window = widget->getParentWindow();
+
+    for (size_t i = 0; i < overlays.size(); ++i)
+    {
+        if (&overlays[i]->fWindow == &window)
+            return overlays[i];
+    }
+
+    return nullptr;
+}
+
+void PopupOverlay::open(Popup *popup, Point<int> position)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(popup != nullptr, );
+
+    if (fPopup != nullptr && fPopup != popup)
+        fPopup->onPopupClosed();
+
+    fPopup = popup;
+
+    //the overlay covers the whole window, which may have been resized since the last popup
+    setAbsolutePos(0, 0);
+    setSize(fWindow.getWidth(), fWindow.getHeight());
+
+    const Size<uint> size = popup->getPopupSize(*this);
+
+    const int x = std::max(0, std::min(position.getX(), (int)fWindow.getWidth() - (int)size.getWidth()));
+    const int y = std::max(0, std::min(position.getY(), (int)fWindow.getHeight() - (int)size.getHeight()));
+
+    fPopupBounds = Rectangle<int>(x, y, size.getWidth(), size.getHeight());
+
+    setVisible(true);
+    repaint();
+}
+
+void PopupOverlay::close(Popup *popup)
+{
+    if (popup == nullptr || fPopup != popup)
+        return;
+
+    fPopup = nullptr;
+
+    setVisible(false);
+    fWindow.repaint();
+
+    popup->onPopupClosed();
+}
+
+bool PopupOverlay::isOpen(const Popup *popup) const
+{
+    return popup != nullptr && fPopup == popup;
+}
+
+bool PopupOverlay::popupContains(Point<int> pos) const
+{
+    return pos.getX() >= fPopupBounds.getX() && pos.getX() < fPopupBounds.getX() + (int)fPopupBounds.getWidth() && pos.getY() >= fPopupBounds.getY() && pos.getY() < fPopupBounds.getY() + (int)fPopupBounds.getHeight();
+}
+
+void PopupOverlay::onNanoDisplay()
+{
+    if (fPopup == nullptr)
+        return;
+
+    translate(fPopupBounds.getX(), fPopupBounds.getY());
+
+    fPopup->onPopupDisplay(*this);
+}
+
+bool PopupOverlay::onMouse(const MouseEvent &ev)
+{
+    if (fPopup == nullptr)
+        return false;
+
+    if (!popupContains(ev.pos))
+    {
+        //a click outside closes the popup, and still reaches the widgets below
+        if (ev.press)
+            close(fPopup);
+
+        return false;
+    }
+
+    MouseEvent popupEvent = ev;
+    popupEvent.pos = Point<int>(ev.pos.getX() - fPopupBounds.getX(), ev.pos.getY() - fPopupBounds.getY());
+
+    return fPopup->onPopupMouse(popupEvent);
+}
+
+bool PopupOverlay::onMotion(const MotionEvent &ev)
+{
+    if (fPopup == nullptr)
+        return false;
+
+    MotionEvent popupEvent = ev;
+    popupEvent.pos = Point<int>(ev.pos.getX() - fPopupBounds.getX(), ev.pos.getY() - fPopupBounds.getY());
+
+    //the popup also sees the cursor leave, but the widgets below keep receiving motion outside of it
+    const bool handled = fPopup->onPopupMotion(popupEvent);
+
+    return popupContains(ev.pos) && handled;
+}
+
+END_NAMESPACE_DISTRHO
@@ -3,15 +3,16 @@
 START_NAMESPACE_DISTRHO
 
 RemoveDCSwitch::RemoveDCSwitch(NanoWidget *widget, Size<uint> size) noexcept : NanoSwitch(widget, size),
+                                                                               fFrameScheduler(FrameScheduler::attach(this)),
 
                                                                                fSocketColor(27, 27, 27, 255),
-                                                                               fSocketColorTransition(0.080f, &fSocketColor, Color(59, 36, 27, 255)),
+                                                                               fSocketColorTransition(fFrameScheduler->getAnimationEngine(), 0.080f, &fSocketColor, Color(59, 36, 27, 255)),
 
                                                                                fGlowIcol(Color(210, 123, 30, 0)),
-                                                                               fGlowIcolTransition(0.200f, &fGlowIcol, Color(210, 123, 30, 125)),
+                                                                               fGlowIcolTransition(fFrameScheduler->getAnimationEngine(), 0.200f, &fGlowIcol, Color(210, 123, 30, 125)),
 
                                                                                fMainRectColor(Color(73, 73, 73, 255)),
-                                                                               fMainRectColorTransition(0.150f, &fMainRectColor, Color(234, 151, 39, 255))
+                                                                               fMainRectColorTransition(fFrameScheduler->getAnimationEngine(), 0.150f, &fMainRectColor, Color(234, 151, 39, 255))
 {
     const float socketMargin = 2.0f; //how much we can see the socket behind the main square
     const float doubleSocketMargin = socketMargin * 2.0f;
@@ -24,44 +25,15 @@ RemoveDCSwitch::RemoveDCSwitch(NanoWidget *widget, Size<uint> size) noexcept : N
     const float mainRectHalfWidth = mainRectWidth / 2.0f;
     const float mainRectCenter = mainRectTopLeft + mainRectHalfWidth;
 
-    widget->getParentWindow().addIdleCallback(this);
-
     const Paint targetGradient = radialGradient(mainRectCenter, mainRectCenter, 0.5f, mainRectHalfWidth, Color(254, 224, 191, 255), Color(240, 199, 154, 0));
 
     fMainRectGradient = radialGradient(mainRectCenter, mainRectCenter, 0.5f, mainRectHalfWidth, Color(113, 113, 113, 255), Color(73, 73, 73, 0));
-    fMainRectGradientTransition = GradientTransition(0.010f, &fMainRectGradient, targetGradient);
+    fMainRectGradientTransition = GradientTransition(fFrameScheduler->getAnimationEngine(), 0.010f, &fMainRectGradient, targetGradient);
 }
 
-void RemoveDCSwitch::idleCallback()
+RemoveDCSwitch::~RemoveDCSwitch()
 {
-    bool mustRepaint = false;
-
-    if (fSocketColorTransition.isPlaying())
-    {
-        fSocketColorTransition.run();
-        mustRepaint = true;
-    }
-
-    if (fGlowIcolTransition.isPlaying())
-    {
-        fGlowIcolTransition.run();
-        mustRepaint = true;
-    }
-
-    if (fMainRectColorTransition.isPlaying())
-    {
-        fMainRectColorTransition.run();
-        mustRepaint = true;
-    }
-
-    if (fMainRectGradientTransition.isPlaying())
-    {
-        fMainRectGradientTransition.run();
-        mustRepaint = true;
-    }
-
-    if (mustRepaint)
-        repaint();
+    FrameScheduler::detach(this);
 }
 
 void RemoveDCSwitch::onStateChanged()
@@ -70,6 +42,10 @@ void RemoveDCSwitch::onStateChanged()
     fGlowIcolTransition.play(isDown() ? Animation::Forward : Animation::Backward);
     fMainRectColorTransition.play(isDown() ? Animation::Forward : Animation::Backward);
 
+    fFrameScheduler->runAnimation(&fSocketColorTransition, this);
+    fFrameScheduler->runAnimation(&fGlowIcolTransition, this);
+    fFrameScheduler->runAnimation(&fMainRectColorTransition, this);
+
     if (isDown())
     {
         fMainRectGradientTransition.setSpeed(1.0f);
@@ -78,8 +54,10 @@ void RemoveDCSwitch::onStateChanged()
     else
     {
         fMainRectGradientTransition.setSpeed(1.0f / 15.0f);
-        fMainRectGradientTransition.play(Animation::Backward);  
+        fMainRectGradientTransition.play(Animation::Backward);
     }
+
+    fFrameScheduler->runAnimation(&fMainRectGradientTransition, this);
 }
 
 void RemoveDCSwitch::draw()
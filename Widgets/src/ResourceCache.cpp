@@ -0,0 +1,232 @@
+#include "ResourceCache.hpp"
+#include "SVGUtils.hpp"
+#include "Mathf.hpp"
+#include "nanovg.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+
+START_NAMESPACE_DISTRHO
+
+//one cache per NanoVG context, shared by all the widgets drawing with it
+//the contexts of different plugin instances may be used from different threads, so the list is locked
+static std::vector<ResourceCache *> caches;
+static std::mutex cachesMutex;
+
+ResourceCache::ResourceCache(NVGcontext *context) : fContext(context),
+                                                    fWidgetCount(0)
+{
+}
+
+ResourceCache::~ResourceCache()
+{
+    //resources still acquired at this point were leaked by their widgets
+    for (size_t i = 0; i < fResources.size(); ++i)
+        destroy(fResources[i]);
+}
+
+ResourceCache *ResourceCache::attach(NanoWidget *widget)
+{
+    NVGcontext *context = widget->getContext();
+
+    std::lock_guard<std::mutex> lock(cachesMutex);
+
+    ResourceCache *cache = nullptr;
+
+    for (size_t i = 0; i < caches.size(); ++i)
+    {
+        if (caches[i]->fContext == context)
+            cache = caches[i];
+    }
+
+    if (cache == nullptr)
+    {
+        cache = new ResourceCache(context);
+        caches.push_back(cache);
+    }
+
+    ++cache->fWidgetCount;
+
+    return cache;
+}
+
+void ResourceCache::detach(NanoWidget *widget)
+{
+    NVGcontext *context = widget->getContext();
+
+    std::lock_guard<std::mutex> lock(cachesMutex);
+
+    for (size_t i = 0; i < caches.size(); ++i)
+    {
+        ResourceCache *cache = caches[i];
+
+        if (cache->fContext != context)
+            continue;
+
+        if (--cache->fWidgetCount == 0)
+        {
+            caches.erase(caches.begin() + i);
+            delete cache;
+        }
+
+        return;
+    }
+}
+
+ResourceCache::Resource *ResourceCache::find(Kind kind, Size<uint> size, const std::string &params)
+{
+    for (size_t i = 0; i < fResources.size(); ++i)
+    {
+        Resource *resource = fResources[i];
+
+        if (resource->kind == kind && resource->size == size && resource->params == params)
+        {
+            ++resource->refCount;
+            return resource;
+        }
+    }
+
+    return nullptr;
+}
+
+ResourceCache::Resource *ResourceCache::create(Kind kind, Size<uint> size, const std::string &params)
+{
+    Resource *resource = new Resource();
+
+    resource->kind = kind;
+    resource->size = size;
+    resource->params = params;
+    resource->refCount = 1;
+    resource->image = -1;
+    resource->svg = nullptr;
+
+    fResources.push_back(resource);
+
+    return resource;
+}
+
+void ResourceCache::destroy(Resource *resource)
+{
+    if (resource->image != -1)
+        nvgDeleteImage(fContext, resource->image);
+
+    if (resource->svg != nullptr)
+        nsvgDelete(resource->svg);
+
+    delete resource;
+}
+
+const ResourceCache::Resource *ResourceCache::acquireNoiseTexture(Size<uint> size)
+{
+    Resource *resource = find(NoiseTexture, size, std::string());
+
+    if (resource != nullptr)
+        return resource;
+
+    resource = create(NoiseTexture, size, std::string());
+
+    const int width = size.getWidth();
+    const int height = size.getHeight();
+
+    unsigned char *imageData = (unsigned char *)malloc(width * height * 4);
+
+    for (int i = 0; i < height; ++i)
+    {
+        for (int j = 0; j < width; ++j)
+        {
+            int index = i * (width * 4) + (j * 4);
+
+            int min = 0;
+            int max = 8;
+            int noiseFloor = 5;
+
+            int random = min + (std::rand() % static_cast<int>(max - min + 1));
+
+            float t;
+
+            if (random > noiseFloor)
+            {
+                t = (float)random / max;
+            }
+            else
+            {
+                t = 0;
+            }
+
+            imageData[index + 0] = wolf::lerp(35, 40, t);
+            imageData[index + 1] = wolf::lerp(38, 43, t);
+            imageData[index + 2] = wolf::lerp(41, 44, t);
+            imageData[index + 3] = 255;
+        }
+    }
+
+    resource->image = nvgCreateImageRGBA(fContext, width, height, 0, imageData);
+    resource->paints[0] = nvgImagePattern(fContext, 0, 0, width, height, 0, resource->image, 1.0f);
+
+    free(imageData);
+
+    return resource;
+}
+
+const ResourceCache::Resource *ResourceCache::acquireSvg(const char *path, const char *units, float dpi)
+{
+    char params[512];
+    std::snprintf(params, sizeof(params), "%s %s %f", path, units, dpi);
+
+    Resource *resource = find(Svg, Size<uint>(), params);
+
+    if (resource != nullptr)
+        return resource;
+
+    //a file which can't be parsed isn't cached, so that the next widget tries again
+    NSVGimage *svg = nsvgParseFromFile(path, units, dpi);
+
+    DISTRHO_SAFE_ASSERT_RETURN(svg != nullptr, nullptr);
+
+    resource = create(Svg, Size<uint>(), params);
+    resource->svg = svg;
+
+    return resource;
+}
+
+const ResourceCache::Resource *ResourceCache::acquirePaints(const char *name, Size<uint> size, Color color, PaintBuilder build)
+{
+    char params[128];
+    std::snprintf(params, sizeof(params), "%s %f %f %f %f", name, color.red, color.green, color.blue, color.alpha);
+
+    Resource *resource = find(Paints, size, params);
+
+    if (resource != nullptr)
+        return resource;
+
+    resource = create(Paints, size, params);
+
+    build(fContext, size, color, resource->paints);
+
+    return resource;
+}
+
+void ResourceCache::release(const Resource *resource)
+{
+    if (resource == nullptr)
+        return;
+
+    for (size_t i = 0; i < fResources.size(); ++i)
+    {
+        if (fResources[i] != resource)
+            continue;
+
+        if (--fResources[i]->refCount == 0)
+        {
+            destroy(fResources[i]);
+            fResources.erase(fResources.begin() + i);
+        }
+
+        return;
+    }
+
+    DISTRHO_SAFE_ASSERT(false);
+}
+
+END_NAMESPACE_DISTRHO
@@ -1,6 +1,6 @@
 #include "RightClickMenu.hpp"
 #include "Config.hpp"
-#include <unistd.h>
+#include <cstring>
 
 START_NAMESPACE_DISTRHO
 
@@ -63,25 +63,20 @@ RightClickMenuSection::RightClickMenuSection(const char *label) noexcept : Right
     fIsSection = true;
 }
 
-RightClickMenu::RightClickMenu(NanoWidget *parent) noexcept : Window(parent->getParentApp(), parent->getParentWindow()),
-                                                              NanoWidget((Window &)*this),
-                                                              fParent(parent),
+RightClickMenu::RightClickMenu(NanoWidget *parent) noexcept : fParent(parent),
                                                               fFontSize(17.0f),
                                                               fSectionFontSize(14.0f),
                                                               fHoveredIndex(-1),
                                                               fLongestWidth(0.0f),
                                                               fBorderColor(CONFIG_NAMESPACE::right_click_menu_border_color),
-                                                              fMargin(Margin(7, 15, 7, 13))
+                                                              fMargin(Margin(7, 15, 7, 13)),
+                                                              fCallback(nullptr)
 {
-    Window::setResizable(false);
-    Window::setBorderless(true);
-
-    loadSharedResources();
 }
 
 RightClickMenu::~RightClickMenu()
 {
-    Window::close();
+    close();
 }
 
 void RightClickMenu::show(int posX, int posY)
@@ -90,33 +85,18 @@ void RightClickMenu::show(int posX, int posY)
     posX += 2;
     posY += 2;
 
-    adaptSize();
-
-    Window::hideFromTaskbar();
-
-    Window &parentWindow = fParent->getParentWindow();
-    Point<int> windowPos = parentWindow.getAbsolutePos();
-
-    //FIXME: this is really a mess... right now, it's necessary to set the size before and after the exec to get the correct window dimensions on win32...
-    //it still flickers a bit, so it's not a perfect solution
-#if defined(DISTRHO_OS_WINDOWS)
-    adaptSize();
+    PopupOverlay *overlay = PopupOverlay::get(fParent);
+    DISTRHO_SAFE_ASSERT_RETURN(overlay != nullptr, );
 
-    Window::setAbsolutePos(posX + windowPos.getX(), posY + windowPos.getY());
-#endif
-
-    Window::exec(false);
-
-#if defined(DISTRHO_OS_WINDOWS)
-    adaptSize();
-#endif
-
-    Window::setAbsolutePos(posX + windowPos.getX(), posY + windowPos.getY());
+    overlay->open(this, Point<int>(posX, posY));
 }
 
 void RightClickMenu::close()
 {
-    Window::close();
+    PopupOverlay *overlay = PopupOverlay::get(fParent);
+
+    if (overlay != nullptr)
+        overlay->close(this);
 }
 
 void RightClickMenu::setBorderColor(const Color color)
@@ -134,27 +114,27 @@ void RightClickMenu::setSectionFontSize(float fontSize)
     fSectionFontSize = fontSize;
 }
 
-Rectangle<float> RightClickMenu::getBoundsOfItemComment(const int index)
+Rectangle<float> RightClickMenu::getBoundsOfItemComment(NanoVG &context, const int index)
 {
-    fontSize(fSectionFontSize);
-    textAlign(ALIGN_LEFT | ALIGN_TOP);
+    context.fontSize(fSectionFontSize);
+    context.textAlign(NanoVG::ALIGN_LEFT | NanoVG::ALIGN_TOP);
 
     Rectangle<float> bounds;
-    Rectangle<float> itemBounds = getBoundsOfItem(index);
+    Rectangle<float> itemBounds = getBoundsOfItem(context, index);
 
-    textBounds(itemBounds.getX() + itemBounds.getWidth(), index * fFontSize + fMargin.top, fItems[index].getComment(), NULL, bounds);
+    context.textBounds(itemBounds.getX() + itemBounds.getWidth(), index * fFontSize + fMargin.top, fItems[index].getComment(), NULL, bounds);
 
     return bounds;
 }
 
-Rectangle<float> RightClickMenu::getBoundsOfItem(const int index)
+Rectangle<float> RightClickMenu::getBoundsOfItem(NanoVG &context, const int index)
 {
-    fontSize(fFontSize);
-    textAlign(ALIGN_LEFT | ALIGN_TOP);
+    context.fontSize(fFontSize);
+    context.textAlign(NanoVG::ALIGN_LEFT | NanoVG::ALIGN_TOP);
 
     Rectangle<float> bounds;
 
-    textBounds(0 + fMargin.left, index * fFontSize + fMargin.top, fItems[index].getLabel(), NULL, bounds);
+    context.textBounds(0 + fMargin.left, index * fFontSize + fMargin.top, fItems[index].getLabel(), NULL, bounds);
 
     return bounds;
 }
@@ -187,14 +167,24 @@ void RightClickMenu::setSectionEnabled(int index, bool enabled)
     }
 }
 
-void RightClickMenu::adaptSize()
+Size<uint> RightClickMenu::getPopupSize(NanoVG &context)
 {
-    findLongestItem();
+    findLongestItem(context);
+
+    fSize = Size<uint>(fLongestWidth + fMargin.left + fMargin.right + 12, fItems.size() * fFontSize + fMargin.top + fMargin.bottom);
 
-    const Size<uint> size = Size<uint>(fLongestWidth + fMargin.left + fMargin.right + 12, fItems.size() * fFontSize + fMargin.top + fMargin.bottom);
+    //the events don't come with a context, so the hit boxes of the items are measured here
+    fItemBounds.clear();
 
-    Window::setSize(size);
-    NanoWidget::setSize(size);
+    for (size_t i = 0; i < fItems.size(); ++i)
+    {
+        Rectangle<float> itemBounds = getBoundsOfItem(context, i);
+        itemBounds.setWidth(fSize.getWidth() - fMargin.right);
+
+        fItemBounds.push_back(itemBounds);
+    }
+
+    return fSize;
 }
 
 RightClickMenuItem *RightClickMenu::getItemById(int id)
@@ -216,17 +206,17 @@ bool RightClickMenuItem::hasComment()
     return strcmp(fComment, "") != 0;
 }
 
-void RightClickMenu::findLongestItem()
+void RightClickMenu::findLongestItem(NanoVG &context)
 {
     fLongestWidth = 0.0f;
 
     for (size_t i = 0; i < fItems.size(); ++i)
     {
-        float itemWidth = getBoundsOfItem(i).getWidth();
+        float itemWidth = getBoundsOfItem(context, i).getWidth();
 
         if (fItems[i].hasComment())
         {
-            itemWidth += getBoundsOfItemComment(i).getWidth();
+            itemWidth += getBoundsOfItemComment(context, i).getWidth();
         }
 
         if (itemWidth > fLongestWidth)
@@ -257,33 +247,33 @@ void RightClickMenu::setCallback(Callback *callback) noexcept
     fCallback = callback;
 }
 
-void RightClickMenu::onNanoDisplay()
+void RightClickMenu::onPopupDisplay(NanoVG &context)
 {
-    const float width = NanoWidget::getWidth();
-    const float height = NanoWidget::getHeight();
+    const float width = fSize.getWidth();
+    const float height = fSize.getHeight();
 
-    beginPath();
+    context.beginPath();
 
     Rectangle<float> bounds;
 
-    fontSize(fFontSize);
-    textAlign(ALIGN_LEFT | ALIGN_TOP);
-    textBounds(0, 0, fItems[0].getLabel(), NULL, bounds);
+    context.fontSize(fFontSize);
+    context.textAlign(NanoVG::ALIGN_LEFT | NanoVG::ALIGN_TOP);
+    context.textBounds(0, 0, fItems[0].getLabel(), NULL, bounds);
 
-    fillColor(Color(39, 39, 39, 255));
+    context.fillColor(Color(39, 39, 39, 255));
 
-    strokeColor(fBorderColor);
-    strokeWidth(3.0f);
+    context.strokeColor(fBorderColor);
+    context.strokeWidth(3.0f);
 
-    rect(0, 0, width, height);
-    fill();
-    stroke();
+    context.rect(0, 0, width, height);
+    context.fill();
+    context.stroke();
 
-    closePath();
+    context.closePath();
 
     float verticalOffset = 0;
 
-    translate(fMargin.left, fMargin.top);
+    context.translate(fMargin.left, fMargin.top);
 
     for (size_t i = 0; i < fItems.size(); ++i)
     {
@@ -292,66 +282,65 @@ void RightClickMenu::onNanoDisplay()
 
         if (i == fHoveredIndex)
         {
-            beginPath();
+            context.beginPath();
 
-            fillColor(Color(255, 255, 255));
-            rect(0, verticalOffset, width - fMargin.right, fFontSize);
-            fill();
+            context.fillColor(Color(255, 255, 255));
+            context.rect(0, verticalOffset, width - fMargin.right, fFontSize);
+            context.fill();
 
-            closePath();
+            context.closePath();
         }
 
-        beginPath();
+        context.beginPath();
 
         if (fItems[i].isSection())
         {
-            fontSize(fSectionFontSize);
+            context.fontSize(fSectionFontSize);
         }
         else
         {
-            fontSize(fFontSize);
+            context.fontSize(fFontSize);
         }
 
         if (fItems[i].getEnabled() == true)
         {
-            fillColor(itemTextColorEnabled);
+            context.fillColor(itemTextColorEnabled);
         }
         else
         {
-            fillColor(itemTextColorDisabled);
+            context.fillColor(itemTextColorDisabled);
         }
 
-        text(fItems[i].isSection() ? 0 : 14, verticalOffset, fItems[i].getLabel(), NULL);
+        context.text(fItems[i].isSection() ? 0 : 14, verticalOffset, fItems[i].getLabel(), NULL);
 
         if (fItems[i].hasComment())
         {
-            fontSize(fSectionFontSize);
-            fillColor(itemTextColorDisabled);
+            context.fontSize(fSectionFontSize);
+            context.fillColor(itemTextColorDisabled);
 
-            text(getBoundsOfItem(i).getWidth() + 14 + 4, verticalOffset, fItems[i].getComment(), NULL);
+            context.text(getBoundsOfItem(context, i).getWidth() + 14 + 4, verticalOffset, fItems[i].getComment(), NULL);
         }
 
         if (fItems[i].getSelected())
         {
-            fontSize(fFontSize);
-            fillColor(itemTextColorEnabled);
-            text(0, verticalOffset, "✓", NULL);
+            context.fontSize(fFontSize);
+            context.fillColor(itemTextColorEnabled);
+            context.text(0, verticalOffset, "✓", NULL);
         }
 
         verticalOffset += bounds.getHeight();
 
-        closePath();
+        context.closePath();
     }
 }
 
-bool RightClickMenu::onMouse(const MouseEvent &ev)
+bool RightClickMenu::onPopupMouse(const Widget::MouseEvent &ev)
 {
     if (ev.press == true)
     {
         for (size_t i = 0; i < fItems.size(); ++i)
         {
-            Rectangle<float> itemBounds = getBoundsOfItem(i);
-            itemBounds.setWidth(Widget::getWidth() - fMargin.right);
+            const Rectangle<float> &itemBounds = fItemBounds[i];
 
             if (fItems[i].getEnabled() == true && itemBounds.contains(Point<float>(ev.pos.getX(), ev.pos.getY())) && !fItems[i].isSection())
             {
@@ -367,14 +356,13 @@ bool RightClickMenu::onMouse(const MouseEvent &ev)
     return true;
 }
 
-bool RightClickMenu::onMotion(const MotionEvent &ev)
+bool RightClickMenu::onPopupMotion(const Widget::MotionEvent &ev)
 {
-    Widget::repaint();
+    PopupOverlay::get(fParent)->repaint();
 
     for (size_t i = 0; i < fItems.size(); ++i)
     {
-        Rectangle<float> itemBounds = getBoundsOfItem(i);
-        itemBounds.setWidth(Widget::getWidth() - fMargin.right);
+        const Rectangle<float> &itemBounds = fItemBounds[i];
 
         if (fItems[i].getEnabled() == true && itemBounds.contains(Point<float>(ev.pos.getX(), ev.pos.getY())) && !fItems[i].isSection())
         {
@@ -387,12 +375,7 @@ bool RightClickMenu::onMotion(const MotionEvent &ev)
     return true;
 }
 
-void RightClickMenu::onFocusOut()
-{
-    close();
-}
-
-void RightClickMenu::onClose()
+void RightClickMenu::onPopupClosed()
 {
     fHoveredIndex = -1;
 }
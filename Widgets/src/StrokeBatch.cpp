@@ -0,0 +1,67 @@
+#include "StrokeBatch.hpp"
+
+START_NAMESPACE_DISTRHO
+
+StrokeBatch::StrokeBatch()
+{
+}
+
+int StrokeBatch::getStyleIndex(const Color &color, float width)
+{
+    for (size_t i = 0; i < fStyles.size(); ++i)
+    {
+        if (fStyles[i].color == color && fStyles[i].width == width)
+            return i;
+    }
+
+    Style style;
+    style.color = color;
+    style.width = width;
+
+    fStyles.push_back(style);
+
+    return fStyles.size() - 1;
+}
+
+void StrokeBatch::addLine(const Color &color, float width, float x1, float y1, float x2, float y2)
+{
+    Segment segment;
+    segment.style = getStyleIndex(color, width);
+    segment.x1 = x1;
+    segment.y1 = y1;
+    segment.x2 = x2;
+    segment.y2 = y2;
+
+    fSegments.push_back(segment);
+}
+
+void StrokeBatch::submit(NanoVG &nanovg)
+{
+    for (size_t style = 0; style < fStyles.size(); ++style)
+    {
+        nanovg.beginPath();
+
+        nanovg.strokeColor(fStyles[style].color);
+        nanovg.strokeWidth(fStyles[style].width);
+
+        for (size_t i = 0; i < fSegments.size(); ++i)
+        {
+            const Segment &segment = fSegments[i];
+
+            if (segment.style != (int)style)
+                continue;
+
+            nanovg.moveTo(segment.x1, segment.y1);
+            nanovg.lineTo(segment.x2, segment.y2);
+        }
+
+        nanovg.stroke();
+
+        nanovg.closePath();
+    }
+
+    fStyles.clear();
+    fSegments.clear();
+}
+
+END_NAMESPACE_DISTRHO
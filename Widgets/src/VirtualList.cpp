@@ -0,0 +1,233 @@
+#include "VirtualList.hpp"
+#include "Mathf.hpp"
+
+#include <cmath>
+
+START_NAMESPACE_DISTRHO
+
+VirtualList::VirtualList(NanoWidget *widget, Size<uint> size, Delegate *delegate, Orientation orientation) noexcept : NanoWidget(widget),
+                                                                                                                      fDelegate(delegate),
+                                                                                                                      fOrientation(orientation),
+                                                                                                                      fFrameScheduler(nullptr),
+                                                                                                                      fItemCount(0),
+                                                                                                                      fItemExtent(24),
+                                                                                                                      fScrollOffset(0.0f)
+{
+    DISTRHO_SAFE_ASSERT(delegate != nullptr);
+
+    //attached first, since resizing lays the items out
+    fFrameScheduler = FrameScheduler::attach(this);
+
+    setSize(size);
+}
+
+VirtualList::~VirtualList()
+{
+    for (size_t i = 0; i < fBoundWidgets.size(); ++i)
+    {
+        delete fBoundWidgets[i].widget;
+    }
+
+    for (size_t i = 0; i < fRecycledWidgets.size(); ++i)
+    {
+        delete fRecycledWidgets[i];
+    }
+
+    FrameScheduler::detach(this);
+}
+
+void VirtualList::setItemCount(int count)
+{
+    fItemCount = std::max(0, count);
+    fScrollOffset = wolf::clamp(fScrollOffset, 0.0f, getMaxScrollOffset());
+
+    refreshItems();
+}
+
+int VirtualList::getItemCount()
+{
+    return fItemCount;
+}
+
+void VirtualList::setItemExtent(uint extent)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(extent > 0, );
+
+    fItemExtent = extent;
+    fScrollOffset = wolf::clamp(fScrollOffset, 0.0f, getMaxScrollOffset());
+
+    refreshItems();
+}
+
+uint VirtualList::getItemExtent()
+{
+    return fItemExtent;
+}
+
+uint VirtualList::getViewExtent()
+{
+    return fOrientation == Vertical ? getHeight() : getWidth();
+}
+
+float VirtualList::getMaxScrollOffset()
+{
+    return std::max(0.0f, (float)fItemCount * fItemExtent - getViewExtent());
+}
+
+void VirtualList::setScrollOffset(float offset)
+{
+    offset = wolf::clamp(offset, 0.0f, getMaxScrollOffset());
+
+    if (offset == fScrollOffset)
+        return;
+
+    fScrollOffset = offset;
+
+    updateVisibleItems();
+}
+
+float VirtualList::getScrollOffset()
+{
+    return fScrollOffset;
+}
+
+void VirtualList::scrollToItem(int index)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(index >= 0 && index < fItemCount, );
+
+    const float start = (float)index * fItemExtent;
+    const float end = start + fItemExtent;
+
+    //scroll as little as possible to bring the item into view
+    if (start < fScrollOffset)
+        setScrollOffset(start);
+    else if (end > fScrollOffset + getViewExtent())
+        setScrollOffset(end - getViewExtent());
+}
+
+void VirtualList::refreshItems()
+{
+    //unbind everything, so that the widgets in view are bound again
+    for (size_t i = 0; i < fBoundWidgets.size(); ++i)
+    {
+        fBoundWidgets[i].widget->hide();
+        fRecycledWidgets.push_back(fBoundWidgets[i].widget);
+    }
+
+    fBoundWidgets.clear();
+
+    updateVisibleItems();
+}
+
+void VirtualList::updateVisibleItems()
+{
+    //DGL doesn't clip subwidgets to their parent, so the items partly scrolled out are left without a widget
+    //(the half pixel matches the rounding of the positions of the widgets)
+    const int first = std::ceil((fScrollOffset - 0.5f) / fItemExtent);
+    const int last = std::min(fItemCount, (int)std::floor((fScrollOffset + getViewExtent() + 0.5f) / fItemExtent));
+
+    //recycle the widgets of the items which left the view
+    for (size_t i = fBoundWidgets.size(); i-- > 0;)
+    {
+        const BoundWidget &boundWidget = fBoundWidgets[i];
+
+        if (boundWidget.index >= first && boundWidget.index < last)
+            continue;
+
+        boundWidget.widget->hide();
+        fRecycledWidgets.push_back(boundWidget.widget);
+
+        fBoundWidgets[i] = fBoundWidgets.back();
+        fBoundWidgets.pop_back();
+    }
+
+    for (int index = first; index < last; ++index)
+    {
+        bool isBound = false;
+
+        for (size_t i = 0; i < fBoundWidgets.size(); ++i)
+        {
+            if (fBoundWidgets[i].index == index)
+            {
+                positionItemWidget(fBoundWidgets[i].widget, index);
+                isBound = true;
+
+                break;
+            }
+        }
+
+        if (isBound)
+            continue;
+
+        NanoWidget *widget;
+
+        if (!fRecycledWidgets.empty())
+        {
+            widget = fRecycledWidgets.back();
+            fRecycledWidgets.pop_back();
+        }
+        else
+        {
+            widget = fDelegate->createItemWidget(this);
+            DISTRHO_SAFE_ASSERT_CONTINUE(widget != nullptr);
+        }
+
+        fDelegate->bindItemWidget(widget, index);
+        positionItemWidget(widget, index);
+        widget->show();
+
+        BoundWidget boundWidget;
+        boundWidget.widget = widget;
+        boundWidget.index = index;
+
+        fBoundWidgets.push_back(boundWidget);
+    }
+
+    fFrameScheduler->markDirty(this, FrameScheduler::StateChanged);
+}
+
+void VirtualList::positionItemWidget(NanoWidget *widget, int index)
+{
+    const int offset = std::round((float)index * fItemExtent - fScrollOffset);
+
+    if (fOrientation == Vertical)
+    {
+        widget->setAbsolutePos(getAbsoluteX(), getAbsoluteY() + offset);
+        widget->setSize(getWidth(), fItemExtent);
+    }
+    else
+    {
+        widget->setAbsolutePos(getAbsoluteX() + offset, getAbsoluteY());
+        widget->setSize(fItemExtent, getHeight());
+    }
+}
+
+void VirtualList::onNanoDisplay()
+{
+}
+
+bool VirtualList::onScroll(const ScrollEvent &ev)
+{
+    if (!contains(ev.pos))
+        return false;
+
+    const float delta = fOrientation == Vertical ? ev.delta.getY() : ev.delta.getX();
+
+    setScrollOffset(fScrollOffset - delta * fItemExtent);
+
+    return true;
+}
+
+void VirtualList::onResize(const ResizeEvent &)
+{
+    fScrollOffset = wolf::clamp(fScrollOffset, 0.0f, getMaxScrollOffset());
+
+    updateVisibleItems();
+}
+
+void VirtualList::onPositionChanged(const PositionChangedEvent &)
+{
+    updateVisibleItems();
+}
+
+END_NAMESPACE_DISTRHO
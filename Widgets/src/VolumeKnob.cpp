@@ -16,30 +16,15 @@ VolumeKnob::VolumeKnob(NanoWidget *widget, Size<uint> size) noexcept : NanoKnob(
 
     fKnobDiameter = diameter;
 
-    fGrowAnimation = new FloatTransition(0.100f, &fKnobDiameter, fKnobDiameter - 7);
-    fHoverAnimation = new ColorTransition(0.200f, &fKnobOCol, fKnobTargetOCol);
+    fFrameScheduler = FrameScheduler::attach(this);
 
-    widget->getParentWindow().addIdleCallback(this);
+    fGrowAnimation = new FloatTransition(fFrameScheduler->getAnimationEngine(), 0.100f, &fKnobDiameter, fKnobDiameter - 7);
+    fHoverAnimation = new ColorTransition(fFrameScheduler->getAnimationEngine(), 0.200f, &fKnobOCol, fKnobTargetOCol);
 }
 
-void VolumeKnob::idleCallback()
+VolumeKnob::~VolumeKnob()
 {
-    bool mustRepaint = false;
-
-    if (fGrowAnimation->isPlaying())
-    {
-        fGrowAnimation->run();
-        mustRepaint = true;
-    }
-
-    if (fHoverAnimation->isPlaying())
-    {
-        fHoverAnimation->run();
-        mustRepaint = true;
-    }
-
-    if (mustRepaint)
-        repaint();
+    FrameScheduler::detach(this);
 }
 
 void VolumeKnob::onMouseHover()
@@ -50,6 +35,7 @@ void VolumeKnob::onMouseHover()
     getParentWindow().setCursorStyle(Window::CursorStyle::Grab);
 
     fHoverAnimation->play(Animation::Forward);
+    fFrameScheduler->runAnimation(fHoverAnimation.get(), this);
 }
 
 void VolumeKnob::onMouseLeave()
@@ -60,6 +46,7 @@ void VolumeKnob::onMouseLeave()
     getParentWindow().setCursorStyle(Window::CursorStyle::Default);
 
     fHoverAnimation->play(Animation::Backward);
+    fFrameScheduler->runAnimation(fHoverAnimation.get(), this);
 }
 
 void VolumeKnob::onMouseDown()
@@ -68,6 +55,7 @@ void VolumeKnob::onMouseDown()
     fGrowAnimation->setDuration(0.100f);
     fGrowAnimation->seek(fGrowAnimation->getCurrentTime() / 2.0f);
     fGrowAnimation->play(Animation::Forward);
+    fFrameScheduler->runAnimation(fGrowAnimation.get(), this);
 }
 
 void VolumeKnob::onMouseUp()
@@ -76,6 +64,7 @@ void VolumeKnob::onMouseUp()
     fGrowAnimation->setDuration(0.400f);
     fGrowAnimation->seek(fGrowAnimation->getCurrentTime() * 2.0f);
     fGrowAnimation->play(Animation::Backward);
+    fFrameScheduler->runAnimation(fGrowAnimation.get(), this);
 }
 
 void VolumeKnob::draw()